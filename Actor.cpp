@@ -34,9 +34,10 @@ void Actor::move(double x, double y, Scene& scene){
             setDirection(South);
         }
     }
+    moving = x != 0.0 || y != 0.0;
     // Compute visual offset if intending to move
-    if (bounce && (x != 0.0 || y != 0.0)) {
-        extraViewOffset = glm::vec2(0, -glm::abs(glm::sin(Helper::GetFrameNumber() * 0.15f)) * 10.0f);
+    if (bounce && moving) {
+        extraViewOffset = glm::vec2(0, bounceOffset(Helper::GetFrameNumber()));
     }
     else {
         extraViewOffset = glm::vec2(0, 0); // Reset if not moving
@@ -66,10 +67,15 @@ void Actor::setPosition(glm::vec2 newPosition) { position = newPosition; }
 
 
 SDL_Texture* Actor::getViewImage() const {
-    if (view_image_damage && Helper::GetFrameNumber() - 30 < frameDamaged){
+    if (animations){
+        int elapsedTicks;
+        const AnimationClip* clip = getCurrentClip(elapsedTicks);
+        if (clip) return clip->texture;
+    }
+    if (view_image_damage && frameDamaged && Helper::GetFrameNumber() - 30 < *frameDamaged){
         return view_image_damage;
     }
-    if (view_image_attack && Helper::GetFrameNumber() - 30 < frameAttacked){
+    if (view_image_attack && frameAttacked && Helper::GetFrameNumber() - 30 < *frameAttacked){
         return view_image_attack;
     }
     if (view_image_back && yDirection == North){
@@ -78,6 +84,34 @@ SDL_Texture* Actor::getViewImage() const {
     return view_image;
 }
 
+const SDL_Rect* Actor::getViewFrame() const {
+    if (!animations) return nullptr;
+    int elapsedTicks;
+    const AnimationClip* clip = getCurrentClip(elapsedTicks);
+    if (!clip) return nullptr;
+    return &clip->frameAt(elapsedTicks);
+}
+
+const AnimationClip* Actor::getCurrentClip(int& elapsedTicks) const {
+    // same priority as the plain view images: damage, attack, then direction
+    int currFrame = Helper::GetFrameNumber();
+    elapsedTicks = 0;
+    const AnimationClip* damageClip = animations->getClip(AnimationState::Damage);
+    if (damageClip != animations->getClip(AnimationState::Idle) && frameDamaged && currFrame - *frameDamaged < damageClip->duration()){
+        elapsedTicks = currFrame - *frameDamaged;
+        return damageClip;
+    }
+    const AnimationClip* attackClip = animations->getClip(AnimationState::Attack);
+    if (attackClip != animations->getClip(AnimationState::Idle) && frameAttacked && currFrame - *frameAttacked < attackClip->duration()){
+        elapsedTicks = currFrame - *frameAttacked;
+        return attackClip;
+    }
+    if (moving){
+        return animations->getClip(yDirection == North ? AnimationState::MoveBack : AnimationState::Move);
+    }
+    return animations->getClip(AnimationState::Idle);
+}
+
 const glm::vec2& Actor::getTransformScale() const { return transform_scale; }
 double Actor::getTransformRotationDegrees() const { return transform_rotation_degrees; }
 const glm::vec2& Actor::getPivotOffset() const { return view_pivot_offset; }
@@ -87,9 +121,17 @@ const glm::vec2 Actor::getAnimationOffset() const { return extraViewOffset; }
 
 void Actor::setPivotPoint(std::optional<double> pivot_x, std::optional<double> pivot_y){
     if (!pivot_x.has_value() || !pivot_y.has_value()){
-        if (view_image != nullptr) {
+        const SDL_Rect* frame = getViewFrame();
+        if (frame != nullptr || view_image != nullptr) {
             int view_width, view_height;
-            SDL_QueryTexture(view_image, nullptr, nullptr, &view_width, &view_height);
+            if (frame) {
+                // animated actors pivot around the middle of a single frame
+                view_width = frame->w;
+                view_height = frame->h;
+            }
+            else {
+                SDL_QueryTexture(view_image, nullptr, nullptr, &view_width, &view_height);
+            }
 
             // set default pivot vals if not set in scene
             if (!pivot_x.has_value()) {
@@ -226,3 +268,78 @@ bool Actor::getPlayedDialogueSFX(){
 void Actor::setPlayedDialogueSFX(bool hasPlayed){
     hasPlayedDialogueSFX = hasPlayed;
 }
+
+bool Actor::hasReactionImages() const {
+    return view_image_damage != nullptr || view_image_attack != nullptr;
+}
+
+void Actor::setAnimations(const AnimationSet* animationSet){
+    animations = animationSet;
+}
+
+bool Actor::isAnimated() const {
+    return animations != nullptr;
+}
+
+bool Actor::isMoving() const { return moving; }
+std::optional<int> Actor::getLastDamagedFrame() const { return frameDamaged; }
+std::optional<int> Actor::getLastAttackedFrame() const { return frameAttacked; }
+
+void Actor::setStaticBaked(bool isBaked){
+    staticBaked = isBaked;
+}
+bool Actor::isStaticBaked() const {
+    return staticBaked;
+}
+
+void Actor::takeRuntimeState(const Actor& previous) {
+    position = previous.position;
+    velocity = previous.velocity;
+    xDirection = previous.xDirection;
+    yDirection = previous.yDirection;
+    reversedDir = previous.reversedDir;
+    frameDamaged = previous.frameDamaged;
+    frameAttacked = previous.frameAttacked;
+    scoreIncreased = previous.scoreIncreased;
+    hasPlayedDialogueSFX = previous.hasPlayedDialogueSFX;
+    moving = previous.moving;
+    extraViewOffset = previous.extraViewOffset;
+    updateCollider(position, ColliderType::Collision);
+    updateCollider(position, ColliderType::Trigger);
+}
+
+ActorState Actor::saveState(int currentFrame) const {
+    ActorState state;
+    state.actorID = actorID;
+    state.position = position;
+    state.velocity = velocity;
+    state.extraViewOffset = extraViewOffset;
+    state.damaged = frameDamaged.has_value();
+    state.attacked = frameAttacked.has_value();
+    state.framesSinceDamaged = currentFrame - frameDamaged.value_or(currentFrame);
+    state.framesSinceAttacked = currentFrame - frameAttacked.value_or(currentFrame);
+    state.xDirection = xDirection;
+    state.yDirection = yDirection;
+    state.reversedDir = reversedDir;
+    state.scoreIncreased = scoreIncreased;
+    state.hasPlayedDialogueSFX = hasPlayedDialogueSFX;
+    state.moving = moving;
+    return state;
+}
+
+void Actor::restoreState(const ActorState& state, int currentFrame) {
+    position = state.position;
+    velocity = state.velocity;
+    extraViewOffset = state.extraViewOffset;
+    frameDamaged = state.damaged ? std::optional<int>(currentFrame - state.framesSinceDamaged) : std::nullopt;
+    frameAttacked = state.attacked ? std::optional<int>(currentFrame - state.framesSinceAttacked) : std::nullopt;
+    xDirection = state.xDirection;
+    yDirection = state.yDirection;
+    reversedDir = state.reversedDir;
+    scoreIncreased = state.scoreIncreased;
+    hasPlayedDialogueSFX = state.hasPlayedDialogueSFX;
+    moving = state.moving;
+    collidingActorsThisFrame.clear();
+    updateCollider(position, ColliderType::Collision);
+    updateCollider(position, ColliderType::Trigger);
+}
@@ -17,6 +17,7 @@
 
 #include "glm/glm.hpp"
 #include "Directions.hpp"
+#include "Animation.hpp"
 #ifdef __APPLE__
     #include "SDL2_image/SDL_image.h"
     #include "SDL2_mixer/SDL_mixer.h"
@@ -60,15 +61,40 @@ enum class ColliderType {
     Trigger
 };
 
+// what changes about an actor while the game runs, as plain data so snapshots can copy it as bytes
+// frames are kept as how long before the snapshot they happened, so cooldowns carry on after a restore
+struct ActorState {
+    int actorID = 0;
+    glm::vec2 position = glm::vec2(0, 0);
+    glm::vec2 velocity = glm::vec2(0, 0);
+    glm::vec2 extraViewOffset = glm::vec2(0, 0);
+    int framesSinceDamaged = 0;   // only meaningful when damaged is set
+    int framesSinceAttacked = 0;
+    bool damaged = false;
+    bool attacked = false;
+    Direction xDirection = East;
+    Direction yDirection = South;
+    bool reversedDir = false;
+    bool scoreIncreased = false;
+    bool hasPlayedDialogueSFX = false;
+    bool moving = false;
+};
+
 class Actor
 {
 public:
-    Actor(std::string name, SDL_Texture* view_image, SDL_Texture* view_image_back, SDL_Texture* view_image_damage, SDL_Texture* view_image_attack, glm::vec2 position, glm::vec2 initial_velocity, std::string nearby_dialogue, std::string contact_dialogue, glm::vec2 transform_scale, double transform_rotation_degrees, std::optional<int> order = std::nullopt, bool bounce = false)
+    // id is only given by loaders that hand out a block of ids themselves, otherwise the next g_uuid is taken
+    Actor(std::string name, SDL_Texture* view_image, SDL_Texture* view_image_back, SDL_Texture* view_image_damage, SDL_Texture* view_image_attack, glm::vec2 position, glm::vec2 initial_velocity, std::string nearby_dialogue, std::string contact_dialogue, glm::vec2 transform_scale, double transform_rotation_degrees, std::optional<int> order = std::nullopt, bool bounce = false, std::optional<int> id = std::nullopt)
     : name(name), view_image(view_image), view_image_back(view_image_back), view_image_damage(view_image_damage), view_image_attack(view_image_attack), position(position), velocity(initial_velocity), nearby_dialogue(nearby_dialogue), contact_dialogue(contact_dialogue), transform_scale(transform_scale), transform_rotation_degrees(transform_rotation_degrees),
         render_order(order), bounce(bounce)
     {
-        actorID = g_uuid;
-        g_uuid++;
+        if (id.has_value()) {
+            actorID = id.value();
+        }
+        else {
+            actorID = g_uuid;
+            g_uuid++;
+        }
     };
     
     Actor() {
@@ -90,6 +116,8 @@ public:
     
     const glm::vec2& getPosition() const;
     SDL_Texture* getViewImage() const;
+    // the part of getViewImage() to draw, nullptr for the whole texture
+    const SDL_Rect* getViewFrame() const;
     const glm::vec2& getTransformScale() const;
     double getTransformRotationDegrees() const;
     const glm::vec2& getPivotOffset() const;
@@ -117,6 +145,18 @@ public:
     std::string getNearbyDialogueSFX();
     bool getPlayedDialogueSFX();
     void setPlayedDialogueSFX(bool hasPlayed);
+    bool hasReactionImages() const;
+    void setStaticBaked(bool isBaked);
+    bool isStaticBaked() const;
+    void setAnimations(const AnimationSet* animationSet);
+    bool isAnimated() const;
+    bool isMoving() const;
+    std::optional<int> getLastDamagedFrame() const;
+    std::optional<int> getLastAttackedFrame() const;
+    // hot reload: carries over where the actor is and what it's doing from the actor it replaces
+    void takeRuntimeState(const Actor& previous);
+    ActorState saveState(int currentFrame) const;
+    void restoreState(const ActorState& state, int currentFrame);
     
 private:
     std::string name = "";
@@ -131,8 +171,9 @@ private:
     SDL_Texture* view_image_back = nullptr;
     SDL_Texture* view_image_damage = nullptr;
     SDL_Texture* view_image_attack = nullptr;
-    int frameDamaged = -31; // to never accidentally trigger (img shown for 30 frames)
-    int frameAttacked = -31;
+    // unset until the actor is first hit or attacks, so the damage/attack images and clips never show before that
+    std::optional<int> frameDamaged;
+    std::optional<int> frameAttacked;
     glm::vec2 transform_scale = glm::vec2(1.0, 1.0);
     double transform_rotation_degrees = 0.0;
     glm::vec2 view_pivot_offset = glm::vec2(0,0);
@@ -150,6 +191,10 @@ private:
     std::unordered_set<Actor*> collidingActorsThisFrame;
     std::string nearbyDialogueSFX = "";
     bool hasPlayedDialogueSFX = false;
+    bool staticBaked = false; // drawn as part of the scene's static layer
+    const AnimationSet* animations = nullptr; // owned by the actor's template
+    bool moving = false;
+    const AnimationClip* getCurrentClip(int& elapsedTicks) const;
 };
 
 
@@ -0,0 +1,84 @@
+//
+//  Animation.cpp
+//  game_engine
+//
+
+#include "Animation.hpp"
+#include <algorithm>
+#include <cmath>
+
+void AnimationClip::buildFrames(int frameWidth, int frameHeight, int firstFrame, int frameCount) {
+    frames.clear();
+    int sheetWidth = 0;
+    int sheetHeight = 0;
+    SDL_QueryTexture(texture, nullptr, nullptr, &sheetWidth, &sheetHeight);
+    // frames run left to right, then top to bottom
+    int columns = std::max(1, sheetWidth / frameWidth);
+    if (frameCount <= 0) {
+        frameCount = columns * std::max(1, sheetHeight / frameHeight) - firstFrame;
+    }
+    for (int i = firstFrame; i < firstFrame + frameCount; ++i) {
+        SDL_Rect frame = {(i % columns) * frameWidth, (i / columns) * frameHeight, frameWidth, frameHeight};
+        frames.push_back(frame);
+    }
+}
+
+const SDL_Rect& AnimationClip::frameAt(int elapsedTicks) const {
+    if (loop) {
+        return frames[sharedFrame];
+    }
+    // one shot clips hold their last frame
+    int index = std::max(0, elapsedTicks) / ticksPerFrame;
+    return frames[std::min(index, static_cast<int>(frames.size()) - 1)];
+}
+
+int AnimationClip::duration() const {
+    return loop ? 30 : static_cast<int>(frames.size()) * ticksPerFrame;
+}
+
+void AnimationSet::setClip(AnimationState state, const AnimationClip& clip) {
+    clips[static_cast<int>(state)] = clip;
+    hasClip[static_cast<int>(state)] = !clip.frames.empty() && clip.texture != nullptr;
+}
+
+const AnimationClip* AnimationSet::getClip(AnimationState state) const {
+    int index = static_cast<int>(state);
+    if (hasClip[index]) {
+        return &clips[index];
+    }
+    int idle = static_cast<int>(AnimationState::Idle);
+    return hasClip[idle] ? &clips[idle] : nullptr;
+}
+
+void AnimationSet::advance(int frameNumber) {
+    for (int i = 0; i < ANIMATION_STATE_COUNT; ++i) {
+        if (hasClip[i] && clips[i].loop) {
+            int numFrames = static_cast<int>(clips[i].frames.size());
+            clips[i].sharedFrame = (frameNumber / clips[i].ticksPerFrame) % numFrames;
+        }
+    }
+}
+
+bool AnimationSet::empty() const {
+    return std::none_of(hasClip, hasClip + ANIMATION_STATE_COUNT, [](bool has) { return has; });
+}
+
+bool AnimationSet::stateFromName(const std::string& name, AnimationState& state) {
+    if (name == "idle") state = AnimationState::Idle;
+    else if (name == "move") state = AnimationState::Move;
+    else if (name == "move_back") state = AnimationState::MoveBack;
+    else if (name == "damage") state = AnimationState::Damage;
+    else if (name == "attack") state = AnimationState::Attack;
+    else return false;
+    return true;
+}
+
+float bounceOffset(int frameNumber) {
+    static int cachedFrame = -1;
+    static float cachedOffset = 0.0f;
+    if (frameNumber != cachedFrame) {
+        cachedFrame = frameNumber;
+        cachedOffset = -std::abs(std::sin(frameNumber * 0.15f)) * 10.0f;
+    }
+    return cachedOffset;
+}
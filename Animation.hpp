@@ -0,0 +1,59 @@
+//
+//  Animation.hpp
+//  game_engine
+//
+
+#ifndef Animation_hpp
+#define Animation_hpp
+
+#include <stdio.h>
+#include <vector>
+#include <string>
+#ifdef __APPLE__
+    #include "SDL2/SDL.h"
+#else
+    #include "SDL.h"
+#endif
+
+enum class AnimationState {
+    Idle,
+    Move,
+    MoveBack,
+    Damage,
+    Attack
+};
+#define ANIMATION_STATE_COUNT 5
+
+// frames are sub rects of a single sprite sheet texture
+struct AnimationClip {
+    SDL_Texture* texture = nullptr;
+    std::vector<SDL_Rect> frames;
+    int ticksPerFrame = 6; // engine frames each animation frame is shown for
+    bool loop = true;
+    int sharedFrame = 0; // looping clips share one timeline, advanced once per engine frame
+
+    void buildFrames(int frameWidth, int frameHeight, int firstFrame, int frameCount);
+    // looping clips ignore elapsedTicks and use the shared timeline
+    const SDL_Rect& frameAt(int elapsedTicks) const;
+    // how long a triggered clip stays up, looping clips get the 30 frames the plain images use
+    int duration() const;
+};
+
+// the clips one template defines, looked up by actor state
+class AnimationSet {
+public:
+    void setClip(AnimationState state, const AnimationClip& clip);
+    // falls back to idle when the state has no clip of its own
+    const AnimationClip* getClip(AnimationState state) const;
+    void advance(int frameNumber);
+    bool empty() const;
+    static bool stateFromName(const std::string& name, AnimationState& state);
+private:
+    AnimationClip clips[ANIMATION_STATE_COUNT];
+    bool hasClip[ANIMATION_STATE_COUNT] = {false, false, false, false, false};
+};
+
+// vertical bounce offset for moving actors, computed once per frame and shared by all of them
+float bounceOffset(int frameNumber);
+
+#endif /* Animation_hpp */
@@ -0,0 +1,234 @@
+//
+//  AssetGraph.cpp
+//  game_engine
+//
+
+#include "AssetGraph.hpp"
+#include "Input.hpp"
+#include "Renderer.hpp"
+#include "Audio.hpp"
+#include "JsonFile.hpp"
+#include "SceneStreamReader.hpp"
+#include "ThreadPool.hpp"
+#include <chrono>
+#include <unordered_set>
+
+std::string AssetGraph::nodeKey(ResourceType type, const std::string& name) {
+    return std::to_string(static_cast<int>(type)) + ":" + name;
+}
+
+size_t AssetGraph::addNode(ResourceType type, const std::string& name) {
+    std::string key = nodeKey(type, name);
+    auto it = nodeIndex.find(key);
+    if (it != nodeIndex.end()) return it->second;
+    AssetNode node;
+    node.type = type;
+    node.name = name;
+    nodes.push_back(node);
+    nodeIndex[key] = nodes.size() - 1;
+    return nodes.size() - 1;
+}
+
+void AssetGraph::collectDependencies(const rapidjson::Value& value, std::vector<Dependency>& dependencies) {
+    // the same keys the actor and template loaders read
+    if (!value.IsObject()) return;
+    if (value.HasMember("template") && value["template"].IsString()) {
+        dependencies.emplace_back(ResourceType::Template, value["template"].GetString());
+    }
+    std::vector<std::string> imageNames;
+    Input::collectImageProperties(value, imageNames);
+    for (const std::string& imageName : imageNames) {
+        dependencies.emplace_back(ResourceType::Image, imageName);
+    }
+    static const char* audioProperties[] = {"damage_sfx", "step_sfx", "nearby_dialogue_sfx"};
+    for (const char* property : audioProperties) {
+        if (value.HasMember(property) && value[property].IsString()) {
+            dependencies.emplace_back(ResourceType::Audio, value[property].GetString());
+        }
+    }
+    static const char* dialogueProperties[] = {"nearby_dialogue", "contact_dialogue"};
+    for (const char* property : dialogueProperties) {
+        if (value.HasMember(property) && value[property].IsString()) {
+            std::string sceneName = Input::obtain_word_after_phrase(value[property].GetString(), "proceed to");
+            if (sceneName != "") {
+                dependencies.emplace_back(ResourceType::Scene, sceneName);
+            }
+        }
+    }
+}
+
+void AssetGraph::collectConfigDependencies(const rapidjson::Document& gameConfig, std::vector<Dependency>& dependencies) {
+    auto addString = [&](const char* property, ResourceType type) {
+        if (gameConfig.HasMember(property) && gameConfig[property].IsString()) {
+            dependencies.emplace_back(type, gameConfig[property].GetString());
+        }
+    };
+    addString("font", ResourceType::Font);
+    addString("initial_scene", ResourceType::Scene);
+    addString("hp_image", ResourceType::Image);
+    addString("game_over_bad_image", ResourceType::Image);
+    addString("game_over_good_image", ResourceType::Image);
+    addString("intro_bgm", ResourceType::Audio);
+    addString("gameplay_audio", ResourceType::Audio);
+    addString("game_over_bad_audio", ResourceType::Audio);
+    addString("game_over_good_audio", ResourceType::Audio);
+    addString("score_sfx", ResourceType::Audio);
+    if (gameConfig.HasMember("intro_image") && gameConfig["intro_image"].IsArray()) {
+        for (auto& image : gameConfig["intro_image"].GetArray()) {
+            if (image.IsString()) {
+                dependencies.emplace_back(ResourceType::Image, image.GetString());
+            }
+        }
+    }
+}
+
+std::vector<AssetGraph::Dependency> AssetGraph::scanFile(const AssetNode& node) {
+    // broken or missing files are left for the loaders, which report them when they're actually needed
+    std::vector<Dependency> dependencies;
+    std::optional<ResourceEntry> entry = ResourceManifest::find(node.type, node.name);
+    if (!entry.has_value()) return dependencies;
+    if (node.type == ResourceType::Scene) {
+        // streamed, a scene of any size only ever has one actor's json in memory
+        SceneStreamReader reader(entry->path, false);
+        bool parsed = reader.read([](size_t) {}, [&](const rapidjson::Value& v) {
+            collectDependencies(v, dependencies);
+        });
+        if (parsed) {
+            // emitters placed in the scene itself
+            std::vector<std::string> imageNames;
+            Input::collectImageProperties(reader.getSceneValues(), imageNames);
+            for (const std::string& imageName : imageNames) {
+                dependencies.emplace_back(ResourceType::Image, imageName);
+            }
+        }
+    }
+    else if (node.type == ResourceType::Template) {
+        JsonFile file(entry->path, false, false);
+        rapidjson::Document document;
+        document.Parse(file.getText());
+        if (file.isValid() && !document.HasParseError()) {
+            collectDependencies(document, dependencies);
+        }
+    }
+    return dependencies;
+}
+
+void AssetGraph::build(const rapidjson::Document& gameConfig) {
+    nodes.clear();
+    nodeIndex.clear();
+    rootNode = addNode(ResourceType::Config, "game.config");
+    std::vector<Dependency> configDependencies;
+    collectConfigDependencies(gameConfig, configDependencies);
+
+    // breadth first, each level's scenes and templates read in parallel
+    std::vector<size_t> frontier;
+    auto link = [&](size_t from, const std::vector<Dependency>& dependencies) {
+        std::unordered_set<size_t> linked(nodes[from].dependencies.begin(), nodes[from].dependencies.end());
+        for (const Dependency& dependency : dependencies) {
+            size_t countBefore = nodes.size();
+            size_t to = addNode(dependency.first, dependency.second);
+            if (to != from && linked.insert(to).second) {
+                nodes[from].dependencies.push_back(to);
+            }
+            bool isNew = nodes.size() > countBefore;
+            if (isNew && (dependency.first == ResourceType::Scene || dependency.first == ResourceType::Template)) {
+                frontier.push_back(to);
+            }
+        }
+    };
+    link(rootNode, configDependencies);
+    while (!frontier.empty()) {
+        std::vector<size_t> level;
+        level.swap(frontier);
+        std::vector<std::vector<Dependency>> found(level.size());
+        ThreadPool::shared().parallelFor(level.size(), [&](size_t i) {
+            found[i] = scanFile(nodes[level[i]]);
+        });
+        for (size_t i = 0; i < level.size(); ++i) {
+            link(level[i], found[i]);
+        }
+    }
+}
+
+std::optional<size_t> AssetGraph::findNode(ResourceType type, const std::string& name) const {
+    auto it = nodeIndex.find(nodeKey(type, name));
+    if (it == nodeIndex.end()) return std::nullopt;
+    return it->second;
+}
+
+std::vector<size_t> AssetGraph::closure(size_t node) const {
+    std::vector<size_t> result;
+    std::vector<bool> visited(nodes.size(), false);
+    std::vector<size_t> stack = {node};
+    visited[node] = true;
+    while (!stack.empty()) {
+        size_t current = stack.back();
+        stack.pop_back();
+        result.push_back(current);
+        for (size_t dependency : nodes[current].dependencies) {
+            // the scenes it leads to are their own closures, loaded when the game gets there
+            if (visited[dependency] || nodes[dependency].type == ResourceType::Scene) continue;
+            visited[dependency] = true;
+            stack.push_back(dependency);
+        }
+    }
+    return result;
+}
+
+PrefetchStats AssetGraph::prefetch(const std::vector<size_t>& closureNodes, Renderer& renderer, Audio& audio) const {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::string> imageNames;
+    std::vector<std::string> audioNames;
+    for (size_t index : closureNodes) {
+        const AssetNode& node = nodes[index];
+        if (node.type == ResourceType::Image) {
+            imageNames.push_back(node.name);
+        }
+        else if (node.type == ResourceType::Audio && !audio.isLoaded(node.name) && ResourceManifest::contains(ResourceType::Audio, node.name)
+                 && !audio.isStreamed(node.name)) {
+            // long tracks stream when they play, decoding them up front is what streaming avoids
+            audioNames.push_back(node.name);
+        }
+    }
+    imageNames = renderer.findMissingImages(imageNames);
+
+    // images and audio decode side by side on the pool, then go to their caches on this thread
+    Uint32 format = renderer.getUploadFormat();
+    std::vector<DecodedImage> images(imageNames.size());
+    std::vector<Mix_Chunk*> chunks(audioNames.size(), nullptr);
+    ThreadPool::shared().parallelFor(imageNames.size() + audioNames.size(), [&](size_t i) {
+        if (i < imageNames.size()) {
+            images[i].name = imageNames[i];
+            images[i].surface = Renderer::DecodeImage(imageNames[i], format);
+        }
+        else {
+            size_t audioIndex = i - imageNames.size();
+            chunks[audioIndex] = Audio::decodeAudio(audioNames[audioIndex]);
+        }
+    });
+    PrefetchStats stats;
+    for (const DecodedImage& image : images) {
+        stats.images += image.surface ? 1 : 0;
+    }
+    renderer.UploadImages(images);
+    for (size_t i = 0; i < audioNames.size(); ++i) {
+        if (chunks[i]) {
+            audio.cacheAudio(audioNames[i], chunks[i]);
+            stats.audio++;
+        }
+    }
+    stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+const AssetNode& AssetGraph::getNode(size_t index) const {
+    return nodes[index];
+}
+
+size_t AssetGraph::getNodeCount() const {
+    return nodes.size();
+}
+
+size_t AssetGraph::getRootNode() const {
+    return rootNode;
+}
@@ -0,0 +1,60 @@
+//
+//  AssetGraph.hpp
+//  game_engine
+//
+
+#ifndef AssetGraph_hpp
+#define AssetGraph_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <optional>
+#include <unordered_map>
+#include "rapidjson/document.h"
+#include "ResourceManifest.hpp"
+
+class Renderer;
+class Audio;
+
+struct AssetNode {
+    ResourceType type = ResourceType::Other;
+    std::string name;                  // logical name, as the manifest indexes it
+    std::vector<size_t> dependencies;  // node indices
+};
+
+struct PrefetchStats {
+    int images = 0;
+    int audio = 0;
+    double milliseconds = 0.0;
+};
+
+// what the game can load, worked out from the files before any of it is loaded:
+// game.config -> scenes reachable through "proceed to" -> templates -> images, audio and fonts
+// scenes and templates are read on the thread pool a level at a time, their DOMs aren't kept
+class AssetGraph {
+public:
+    void build(const rapidjson::Document& gameConfig);
+    std::optional<size_t> findNode(ResourceType type, const std::string& name) const;
+    // node and everything it depends on, without going on into the scenes it leads to
+    std::vector<size_t> closure(size_t node) const;
+    // decodes the closure's images and audio in parallel and hands them to the caches
+    PrefetchStats prefetch(const std::vector<size_t>& nodes, Renderer& renderer, Audio& audio) const;
+    const AssetNode& getNode(size_t index) const;
+    size_t getNodeCount() const;
+    size_t getRootNode() const;
+private:
+    using Dependency = std::pair<ResourceType, std::string>;
+    size_t addNode(ResourceType type, const std::string& name);
+    // reads a scene or template file, safe on any thread
+    static std::vector<Dependency> scanFile(const AssetNode& node);
+    static void collectDependencies(const rapidjson::Value& value, std::vector<Dependency>& dependencies);
+    static void collectConfigDependencies(const rapidjson::Document& gameConfig, std::vector<Dependency>& dependencies);
+    static std::string nodeKey(ResourceType type, const std::string& name);
+
+    std::vector<AssetNode> nodes;
+    std::unordered_map<std::string, size_t> nodeIndex;
+    size_t rootNode = 0;
+};
+
+#endif /* AssetGraph_hpp */
@@ -6,31 +6,51 @@
 //
 
 #include "Audio.hpp"
+#include "ResourceManifest.hpp"
+#include "LoadProfiler.hpp"
 #include <iostream>
 void Audio::allocateChannels(int num){
     AudioHelper::Mix_AllocateChannels498(num);
 }
 
 void Audio::loadAudio(const std::string& musicName, Mix_Chunk*& chunk){
-    std::string basePath = "resources/audio/";
-    std::vector<std::string> extensions = {".wav", ".ogg"};
-    // try to load the audio file with supported extensions
-    for (const auto& ext : extensions) {
-        std::string fullPath = basePath + musicName + ext;
-        if (std::filesystem::exists(fullPath)) {
-            chunk = AudioHelper::Mix_LoadWAV498(fullPath.c_str());
-            if (chunk) {
-                // cache the loaded audio
-                loaded_audio[musicName] = chunk;
-                break; // exit the loop once the file is successfully loaded (won't have file w/ same name but diff ext)
-            }
-        }
+    chunk = decodeAudio(musicName);
+    if (chunk) {
+        // cache the loaded audio
+        loaded_audio[musicName] = chunk;
     }
 }
 
-void Audio::playMusic(const std::string& musicName, int channel, int numPlays){
-    std::string basePath = "resources/audio/";
-    std::vector<std::string> extensions = {".wav", ".ogg"};
+Mix_Chunk* Audio::decodeAudio(const std::string& musicName){
+    // the manifest already picked the .wav or .ogg (won't have file w/ same name but diff ext)
+    std::optional<ResourceEntry> entry = ResourceManifest::find(ResourceType::Audio, musicName);
+    if (!entry.has_value()) {
+        return nullptr;
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Mix_Chunk* chunk = nullptr;
+    if (entry->data) {
+        // decoded straight out of the mounted pack
+        chunk = Mix_LoadWAV_RW(ResourceManifest::open(*entry), 1);
+    }
+    else {
+        chunk = AudioHelper::Mix_LoadWAV498(entry->path.c_str());
+    }
+    if (chunk) {
+        LoadProfiler::recordAsset(AssetKind::Audio, musicName, entry->size, LoadProfiler::millisecondsSince(start), false);
+    }
+    return chunk;
+}
+
+void Audio::cacheAudio(const std::string& musicName, Mix_Chunk* chunk){
+    loaded_audio[musicName] = chunk;
+}
+
+bool Audio::isLoaded(const std::string& musicName) const {
+    return loaded_audio.find(musicName) != loaded_audio.end();
+}
+
+Mix_Chunk* Audio::getChunk(const std::string& musicName){
     Mix_Chunk* chunk = nullptr;
 
     // check if the audio is already loaded
@@ -38,6 +58,7 @@ void Audio::playMusic(const std::string& musicName, int channel, int numPlays){
     if (it != loaded_audio.end()) {
         // audio is already loaded, get the chunk
         chunk = it->second;
+        LoadProfiler::recordAsset(AssetKind::Audio, musicName, 0, 0.0, true);
     }
     else {
         loadAudio(musicName, chunk);
@@ -47,12 +68,49 @@ void Audio::playMusic(const std::string& musicName, int channel, int numPlays){
         std::cout << "error: failed to play audio clip " << musicName;
         exit(0);
     }
-    else {
-        // Play the audio on channel num, loop indefinitely (-1)
-        AudioHelper::Mix_PlayChannel498(channel, chunk, numPlays);
+    return chunk;
+}
+
+void Audio::playMusic(const std::string& musicName, int channel, int numPlays){
+    Mix_Chunk* chunk = getChunk(musicName);
+    // Play the audio on channel num, loop indefinitely (-1)
+    AudioHelper::Mix_PlayChannel498(channel, chunk, numPlays);
+}
+
+void Audio::playSound(const std::string& soundName){
+    Mix_Chunk* chunk = getChunk(soundName);
+    int channel = voices.acquire(soundName);
+    if (channel >= 0) {
+        AudioHelper::Mix_PlayChannel498(channel, chunk, 0);
     }
 }
 
+VoiceManager& Audio::getVoices(){
+    return voices;
+}
+
+void Audio::playTrack(const std::string& trackName, int numPlays){
+    // streamed tracks never go near loaded_audio
+    Mix_Chunk* chunk = music.shouldStream(trackName) ? nullptr : getChunk(trackName);
+    music.play(trackName, chunk, numPlays);
+}
+
+void Audio::stopTrack(){
+    music.stop();
+}
+
+void Audio::updateMusic(){
+    music.update();
+}
+
+void Audio::setMusicSettings(uintmax_t streamingThreshold, int crossfadeMilliseconds){
+    music.configure(streamingThreshold, crossfadeMilliseconds);
+}
+
+bool Audio::isStreamed(const std::string& trackName) const {
+    return music.shouldStream(trackName);
+}
+
 void Audio::haltMusic(int channel){
     //if (Mix_Playing(channel)){
         AudioHelper::Mix_HaltChannel498(channel);
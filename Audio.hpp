@@ -21,14 +21,34 @@
     #include "SDL_mixer.h"
 #endif
 #include "External/AudioHelper.h"
+#include "VoiceManager.hpp"
+#include "MusicPlayer.hpp"
 
 class Audio {
 private:
     std::unordered_map<std::string, Mix_Chunk*> loaded_audio;
+    VoiceManager voices;
+    MusicPlayer music;
+    // from the cache or loaded into it, exits if the clip can't be loaded
+    Mix_Chunk* getChunk(const std::string& musicName);
 public:
     void allocateChannels(int num);
     void loadAudio(const std::string& musicName, Mix_Chunk*& chunk);
+    // decodes without touching the cache, so prefetching can run it on the workers
+    static Mix_Chunk* decodeAudio(const std::string& musicName);
+    void cacheAudio(const std::string& musicName, Mix_Chunk* chunk);
+    bool isLoaded(const std::string& musicName) const;
     void playMusic(const std::string& musicName, int channel, int numPlays);
+    // a sound effect, once, on whichever channel the voice manager gives it
+    void playSound(const std::string& soundName);
+    VoiceManager& getVoices();
+    // background music, fades from whatever track is on to this one
+    // long tracks stream instead of being decoded into the cache
+    void playTrack(const std::string& trackName, int numPlays);
+    void stopTrack();
+    void updateMusic();
+    void setMusicSettings(uintmax_t streamingThreshold, int crossfadeMilliseconds);
+    bool isStreamed(const std::string& trackName) const;
     void haltMusic(int channel);
 };
 #endif /* Audio_hpp */
@@ -69,3 +69,7 @@ void Camera::setInitialPosition(glm::vec2 playerStartPos)
 {
     position = playerStartPos + offset;
 }
+
+void Camera::setPosition(glm::vec2 newPosition) {
+    position = newPosition;
+}
@@ -30,6 +30,7 @@ public:
     void setZoomFactor(double zoomFactor);
     void setEaseFactor(float easeFactor);
     void setInitialPosition(glm::vec2 playerStartPos);
+    void setPosition(glm::vec2 newPosition);
     glm::vec2 getPosition() const;
     double getZoomFactor() const;
     float getEaseFactor() const;
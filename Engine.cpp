@@ -5,6 +5,9 @@
 //  Created by Barbara Ribeiro on 1/23/24.
 //
 #include "Engine.hpp"
+#include "JsonFile.hpp"
+#include "ResourceManifest.hpp"
+#include "LoadProfiler.hpp"
 #define CHANNEL_NUM 50
 
 //Initialize
@@ -25,6 +28,8 @@
 Engine::Engine() :  renderer(), gameState(GameState::NoState){}
 // main function for Engine, runs the game loop on it
 void Engine::game_loop() {
+    std::chrono::steady_clock::time_point startupBegin = std::chrono::steady_clock::now();
+    bool startupReported = false;
     IntroHandler intro = IntroHandler(&renderer);
     health = 3;
     score = 0;
@@ -33,27 +38,51 @@ void Engine::game_loop() {
     // load SDL libraries
     renderer.LoadLibraries();
     audio.allocateChannels(CHANNEL_NUM);
+    // 0 and 2 are the music (crossfading between them) and 1 the score sfx, sound effects share the rest
+    audio.getVoices().setChannels(3, CHANNEL_NUM - 3);
     // load config files
     //std::string currSceneStr = loadConfig();
     Input::checkResourcesDirectory();
-    rapidjson::Document game_document;
-    Input::ReadJsonFile("resources/game.config", game_document);
+    JsonFile game_file("resources/game.config");
+    rapidjson::Document& game_document = game_file.getDocument();
+    // the first report runs from here until the initial scene is loaded
+    Input::readLoadProfileConfig(game_document);
+    LoadProfiler::begin("startup", startupBegin);
     Input::readGameFile(renderer, intro, *this, game_document);
+    // every scene reachable from game.config and what each one needs, read before anything is loaded
+    double graphMilliseconds = 0.0;
+    if (assetPrefetch) {
+        std::chrono::steady_clock::time_point graphBegin = std::chrono::steady_clock::now();
+        assetGraph.build(game_document);
+        graphMilliseconds = LoadProfiler::millisecondsSince(graphBegin);
+        LoadProfiler::recordPhase("asset_graph", graphMilliseconds);
+    }
     std::string introSongName = Input::getIntroSong(game_document);
     std::string mainSongName = Input::getMainSong(game_document);
     bool mainSongPlaying = false;
     //camera.configCamera();
     Input::readRenderFile(renderer, camera);
-    SDL_RenderSetScale(renderer.getRendererSDL(), camera.getZoomFactor(), camera.getZoomFactor());
+    renderer.SetScale(camera.getZoomFactor(), camera.getZoomFactor());
     // create window
     renderer.Initialize();
     // play intro music
     // -1 is play on loop
     std::string currSceneStr = Input::getInitialScene(game_document);
+    PrefetchStats prefetchStats;
+    if (assetPrefetch) {
+        prefetchStats = prefetchScene(currSceneStr, true);
+    }
     Scene* currScene = loadScene(currSceneStr);
     camera.setInitialPosition(currScene->getPlayer()->getPosition());
     currScene->sortActorsByRenderOrder();
+    LoadProfiler::end();
+    if (snapshots) {
+        sceneStart = captureSnapshot(*currScene);
+    }
     std::string hp_img = Input::getHPImg(game_document);
+    if (hotReload) {
+        resourceWatcher.start("resources");
+    }
     KeyInput::Init();
     // error if there's a player error but no hp img
     if (currScene->getPlayer() && hp_img == "" ){
@@ -61,9 +90,14 @@ void Engine::game_loop() {
         exit(0);
     }
     if (introSongName != ""){
-        audio.playMusic(introSongName, 0, -1);
+        audio.playTrack(introSongName, -1);
     }
     while (gameState != GameState::Exiting){
+        audio.updateMusic();
+        // nothing on screen is changing, sleep until there's input instead of spinning
+        if (renderer.IsIdle()) {
+            SDL_WaitEventTimeout(nullptr, 100);
+        }
         SDL_Event next_event;
         while (Helper::SDL_PollEvent498(&next_event)) {
             //std::cout << next_event.type << std::endl;
@@ -72,6 +106,10 @@ void Engine::game_loop() {
             if (next_event.type == SDL_QUIT) {
                 changeGameState(GameState::Exiting);
             }
+            // window was uncovered or resized, its contents have to be redrawn
+            if (next_event.type == SDL_WINDOWEVENT) {
+                renderer.MarkDirty();
+            }
             switch (gameState) {
                 case GameState::Intro:
                     intro.ProcessEvent(next_event);
@@ -88,18 +126,18 @@ void Engine::game_loop() {
         // Transition logic
         if (intro.IsDone() && gameState == GameState::Intro) {
             if (introSongName != ""){
-                audio.haltMusic(0);
+                audio.stopTrack();
             }
             gameState = GameState::MainGame;
             // immediate actions upon transition, play new main music song
             if (mainSongName != "") {
-                audio.playMusic(mainSongName, 0, -1);
+                audio.playTrack(mainSongName, -1);
             }
         }
         if (gameState == GameState::MainGame && !mainSongPlaying){
             // immediate actions upon transition, play new main music song
             if (mainSongName != "") {
-                audio.playMusic(mainSongName, 0, -1);
+                audio.playTrack(mainSongName, -1);
             }
             mainSongPlaying = true;
             
@@ -110,19 +148,30 @@ void Engine::game_loop() {
             case GameState::NoState:
                 changeGameState(GameState::Intro);
             case GameState::Intro:
-                intro.Render();
+                if (renderer.FrameChanged()) {
+                    intro.Render();
+                }
                 break;
             case GameState::MainGame:
+                // the scene simulates every frame so it always has something new to show
+                renderer.MarkDirty();
+                if (KeyInput::GetKeyDown(SDL_SCANCODE_F1)) {
+                    renderer.setDebugOverlay(!renderer.getDebugOverlay());
+                }
+                if (resourceWatcher.isRunning()) {
+                    applyResourceChanges(*currScene);
+                }
+                if (snapshots) {
+                    handleSnapshotKeys(currScene);
+                }
                 render(*currScene, hp_img);
                 if (proceedToNextScene){
                     // clear buffer and delete the old scene
                     renderer.StartFrame();
-                    delete currScene;
-                    
-                    // determine scene exists and load it in
-                    Input::findScene(nextSceneStr);
-                    SDL_RenderSetScale(renderer.getRendererSDL(), camera.getZoomFactor(), camera.getZoomFactor());
-                    currScene = loadScene(nextSceneStr);
+                    currScene = changeScene(currScene, nextSceneStr);
+                    if (snapshots) {
+                        sceneStart = captureSnapshot(*currScene);
+                    }
                     render(*currScene, hp_img);
                     proceedToNextScene = false;
                     
@@ -133,8 +182,7 @@ void Engine::game_loop() {
                     changeGameState(GameState::Ending);
                     
                     if (badAudio != ""){
-                        audio.haltMusic(0);
-                        audio.playMusic(badAudio, 0, 0);
+                        audio.playTrack(badAudio, 0);
                     }
                     
                     // show image
@@ -153,8 +201,7 @@ void Engine::game_loop() {
                     changeGameState(GameState::Ending);
                     
                     if (goodAudio != ""){
-                        audio.haltMusic(0);
-                        audio.playMusic(goodAudio, 0, 0);
+                        audio.playTrack(goodAudio, 0);
                     }
                     
                     // show image
@@ -169,7 +216,18 @@ void Engine::game_loop() {
                 }
                 break;
             case GameState::Ending:
-                renderer.RenderImage(endImage);
+                // a retry from the quick-save or the start of the scene picks the game back up
+                if (snapshots && handleSnapshotKeys(currScene)) {
+                    changeGameState(GameState::MainGame);
+                    audio.stopTrack();
+                    if (mainSongName != "") {
+                        audio.playTrack(mainSongName, -1);
+                    }
+                    break;
+                }
+                if (renderer.FrameChanged()) {
+                    renderer.RenderImage(endImage);
+                }
                 break;
             case GameState::Exiting:
                 if (previousState == GameState::Intro){
@@ -182,11 +240,18 @@ void Engine::game_loop() {
                     renderer.RenderImage(endImage);
                 }
                 renderer.EndFrame();
+                audio.getVoices().printStats(std::cout);
                 renderer.Cleanup();
                 exit(0); // quit
                 
         }
         renderer.EndFrame();
+        if (startupReport && !startupReported) {
+            startupReported = true;
+            double startupMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startupBegin).count();
+            std::cout << "startup: first interactive frame after " << startupMilliseconds << " ms (asset graph " << assetGraph.getNodeCount() << " nodes in " << graphMilliseconds << " ms, prefetched " << prefetchStats.images << " images and " << prefetchStats.audio << " audio clips in " << prefetchStats.milliseconds << " ms)" << std::endl;
+            renderer.printTextureStats();
+        }
         //std::cout << "frame number: " << Helper::GetFrameNumber() << std::endl;
         KeyInput::LateUpdate();
     }
@@ -194,8 +259,8 @@ void Engine::game_loop() {
 
 std::string Engine::loadConfig(IntroHandler& intro){
     Input::checkResourcesDirectory();
-    rapidjson::Document game_document;
-    Input::ReadJsonFile("resources/game.config", game_document);
+    JsonFile game_file("resources/game.config");
+    rapidjson::Document& game_document = game_file.getDocument();
     Input::readGameFile(renderer, intro, *this, game_document);
     Input::getIntroSong(game_document);
     return Input::getInitialScene(game_document);
@@ -206,6 +271,17 @@ Scene* Engine::loadScene(const std::string& sceneStr) {
     Scene* scene = new Scene(sceneStr);
     // get info about scene to populate actors
     Input::readScene(*scene, *this, renderer);
+    // the chunks around the start are in place before the first frame, the rest stream in as the camera moves
+    if (WorldStreamer* streamer = scene->getWorldStreamer()) {
+        LoadProfiler::PhaseTimer phase("world_chunks");
+        glm::vec2 startPosition = scene->getPlayer() ? scene->getPlayer()->getPosition() : camera.getPosition();
+        streamer->loadAround(*scene, *this, startPosition);
+    }
+    // bake background scenery into chunk textures
+    {
+        LoadProfiler::PhaseTimer phase("static_layer");
+        scene->bakeStaticLayer(renderer);
+    }
     // sort so they're in order for movement update
     //scene->sortMovingActors();
     return scene;
@@ -233,7 +309,11 @@ std::string Engine::input(){
 void Engine::render(Scene& curr_scene, std::string& hp_img) {
     Actor* player = curr_scene.getPlayer();
     glm::vec2 playerPos = glm::vec2(0.0, 0.0); // default if player doesn't exist
+    if (WorldStreamer* streamer = curr_scene.getWorldStreamer()) {
+        streamer->update(curr_scene, *this, camera.getPosition());
+    }
     curr_scene.updateActors(playerSpeed, audio, stepAudio);
+    advanceAnimations();
     if (player){
         playerPos = player->getPosition();
         camera.update(playerPos, camera.getEaseFactor());
@@ -262,8 +342,7 @@ void Engine::render(Scene& curr_scene, std::string& hp_img) {
             std::string dialogueSFX = actor->getNearbyDialogueSFX();
             if (dialogueSFX != "" && !actor->getPlayedDialogueSFX()){
                 actor->setPlayedDialogueSFX(true);
-                int channel_num = Helper::GetFrameNumber() % 48 + 2;
-                audio.playMusic(dialogueSFX, channel_num, 0);
+                audio.playSound(dialogueSFX);
             }
             int posY = camera.getHeight() - 50 - (numDialogues - 1 - i) * 50;
             renderer.RenderText(nearbyDialogues[i].first, 25, posY);
@@ -282,9 +361,7 @@ void Engine::processDialogueCommands(const std::string& dialogue, Actor& actor,
         health--;
         lastHealthDownFrame = currFrame;// update last health down frame to restart cooldown
         if (damageAudio != ""){
-            // +2 to avoid clobbering channel 0 or 1
-            int channel_num = Helper::GetFrameNumber() % 48 + 2;
-            audio.playMusic(damageAudio, channel_num, 0);
+            audio.playSound(damageAudio);
         }
     }
     if ((dialogue.find("game over") != std::string::npos && currFrame >= lastHealthDownFrame + 180) || health <= 0) {
@@ -328,12 +405,210 @@ void Engine::addTemplate(const std::string& templateName, const Template& newTem
 }
 
 Template& Engine::getTemplate(const std::string& templateName) {
-    return templates[templateName];
+    // lookup only, actors are built from templates on several threads at once
+    return templates.at(templateName);
+}
+
+void Engine::setHotReload(bool enabled) {
+    hotReload = enabled;
+}
+
+void Engine::setSnapshots(bool enabled) {
+    snapshots = enabled;
+}
+
+void Engine::setMusicSettings(uintmax_t streamingThreshold, int crossfadeMilliseconds) {
+    audio.setMusicSettings(streamingThreshold, crossfadeMilliseconds);
+}
+
+void Engine::setVoiceSettings(const VoiceSettings& settings) {
+    audio.getVoices().configure(settings);
+}
+
+void Engine::setAssetPrefetch(bool enabled) {
+    assetPrefetch = enabled;
+}
+
+void Engine::setStartupReport(bool enabled) {
+    startupReport = enabled;
+}
+
+PrefetchStats Engine::prefetchScene(const std::string& scenePath, bool withConfig) {
+    std::vector<size_t> nodes;
+    if (withConfig) {
+        nodes = assetGraph.closure(assetGraph.getRootNode());
+    }
+    // a scene the graph didn't see (written after startup) is simply loaded the usual way
+    std::optional<size_t> sceneNode = assetGraph.findNode(ResourceType::Scene, Input::extractSceneName(scenePath));
+    if (sceneNode.has_value()) {
+        std::vector<size_t> sceneNodes = assetGraph.closure(sceneNode.value());
+        nodes.insert(nodes.end(), sceneNodes.begin(), sceneNodes.end());
+    }
+    PrefetchStats stats = assetGraph.prefetch(nodes, renderer, audio);
+    LoadProfiler::recordPhase("prefetch", stats.milliseconds);
+    return stats;
+}
+
+Scene* Engine::changeScene(Scene* currScene, const std::string& sceneStr) {
+    LoadProfiler::begin(sceneStr);
+    renderer.releaseTextures(currScene->getScenePath());
+    renderer.ClearStaticLayer();
+    delete currScene;
+    
+    // determine scene exists and load it in
+    Input::findScene(sceneStr);
+    renderer.SetScale(camera.getZoomFactor(), camera.getZoomFactor());
+    if (assetPrefetch) {
+        prefetchScene(sceneStr, false);
+    }
+    Scene* scene = loadScene(sceneStr);
+    LoadProfiler::end();
+    // textures shared with the new scene were retained again during the load, the rest can go
+    pruneTemplates(scene->getTemplateNames());
+    renderer.evictUnusedTextures();
+    renderer.printTextureStats();
+    audio.getVoices().printStats(std::cout);
+    return scene;
+}
+
+SceneSnapshot Engine::captureSnapshot(Scene& scene) {
+    SessionState session;
+    int currFrame = Helper::GetFrameNumber();
+    session.health = health;
+    session.score = score;
+    session.framesSinceHealthDown = currFrame - lastHealthDownFrame;
+    session.cameraPosition = camera.getPosition();
+    return SceneSnapshot::capture(scene.getScenePath(), session, scene.getActors(), currFrame);
+}
+
+bool Engine::restoreSnapshot(Scene*& currScene, const SceneSnapshot& snapshot) {
+    if (snapshot.isEmpty()) return false;
+    if (snapshot.getScenePath() != currScene->getScenePath()) {
+        renderer.StartFrame();
+        currScene = changeScene(currScene, snapshot.getScenePath());
+        sceneStart = captureSnapshot(*currScene);
+    }
+    SessionState session;
+    int currFrame = Helper::GetFrameNumber();
+    if (!snapshot.restore(session, currScene->getActors(), currFrame)) {
+        std::cout << "snapshot doesn't match " << currScene->getScenePath() << " anymore, not restored" << std::endl;
+        return false;
+    }
+    health = session.health;
+    score = session.score;
+    lastHealthDownFrame = currFrame - session.framesSinceHealthDown;
+    camera.setPosition(session.cameraPosition);
+    gameOverBad = false;
+    gameOverGood = false;
+    proceedToNextScene = false;
+    // this frame's contacts are stale, chunk actors aren't in snapshots and stream back in fresh
+    currScene->clearDialogues();
+    if (WorldStreamer* streamer = currScene->getWorldStreamer()) {
+        streamer->unloadAll(*currScene);
+    }
+    renderer.MarkDirty();
+    return true;
+}
+
+bool Engine::handleSnapshotKeys(Scene*& currScene) {
+    if (KeyInput::GetKeyDown(SDL_SCANCODE_F5)) {
+        quickSave = captureSnapshot(*currScene);
+        std::cout << "quick-saved " << currScene->getScenePath() << " (" << quickSave.getSize() << " bytes)" << std::endl;
+    }
+    if (KeyInput::GetKeyDown(SDL_SCANCODE_F9)) {
+        return restoreSnapshot(currScene, quickSave);
+    }
+    if (KeyInput::GetKeyDown(SDL_SCANCODE_F8)) {
+        return restoreSnapshot(currScene, sceneStart);
+    }
+    return false;
+}
+
+void Engine::applyResourceChanges(Scene& scene) {
+    std::vector<std::string> changedPaths = resourceWatcher.poll();
+    if (changedPaths.empty()) return;
+    // new files and new sizes
+    ResourceManifest::rescan();
+    
+    std::unordered_set<std::string> changedTemplates;
+    bool sceneChanged = false;
+    bool imagesUpdated = false;
+    bool imagesReplaced = false;
+    for (const std::string& path : changedPaths) {
+        ResourceType type;
+        std::string name;
+        ResourceManifest::identify(path, type, name);
+        if (type == ResourceType::Image) {
+            ImageReloadResult result = renderer.reloadImage(name);
+            imagesUpdated = imagesUpdated || result == ImageReloadResult::UpdatedInPlace;
+            imagesReplaced = imagesReplaced || result == ImageReloadResult::Replaced;
+        }
+        else if (type == ResourceType::Template && isInTemplates(name)) {
+            if (Input::reloadTemplate(name, *this, renderer)) {
+                changedTemplates.insert(name);
+            }
+        }
+        else if (type == ResourceType::Scene && path == scene.getScenePath()) {
+            sceneChanged = true;
+        }
+        else if (scene.getWorldStreamer() && std::filesystem::path(path).extension() == ".chunk") {
+            scene.getWorldStreamer()->reloadChunk(scene, path);
+        }
+    }
+    if (imagesReplaced) {
+        // templates (cached ones from other scenes too) and actors still hold the old textures,
+        // they look their images up again before the old ones are destroyed
+        std::vector<std::string> templateNames;
+        for (const auto& pair : templates) {
+            templateNames.push_back(pair.first);
+        }
+        for (const std::string& templateName : templateNames) {
+            if (changedTemplates.count(templateName) == 0 && Input::reloadTemplate(templateName, *this, renderer)) {
+                changedTemplates.insert(templateName);
+            }
+        }
+    }
+    if (sceneChanged || imagesReplaced || !changedTemplates.empty()) {
+        // chunk actors aren't patched, they're dropped and stream back in built from the new files
+        if (scene.getWorldStreamer()) {
+            scene.getWorldStreamer()->unloadAll(scene);
+        }
+        Input::patchScene(scene, *this, renderer, changedTemplates, imagesReplaced);
+    }
+    else if (imagesUpdated) {
+        // baked chunks hold copies of the old pixels
+        scene.rebakeStaticLayer(renderer);
+    }
+    if (imagesReplaced) {
+        renderer.destroyRetiredTextures();
+    }
+    renderer.MarkDirty();
+}
+
+void Engine::advanceAnimations() {
+    // looping clips are shared by every actor of a template, so each one only moves forward once a frame
+    int currFrame = Helper::GetFrameNumber();
+    for (auto& pair : templates) {
+        pair.second.animations.advance(currFrame);
+    }
+}
+
+void Engine::pruneTemplates(const std::unordered_set<std::string>& inUse) {
+    for (auto it = templates.begin(); it != templates.end();) {
+        if (inUse.find(it->first) == inUse.end()) {
+            renderer.releaseTextures(Template::textureOwner(it->first));
+            it = templates.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
 }
 
 void Engine::changeGameState(GameState newState){
     previousState = gameState;
     gameState = newState;
+    renderer.MarkDirty();
 }
 
 void Engine::setBadAudio(std::string badAudio_in){
@@ -13,6 +13,8 @@
 #include <stdio.h>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <chrono>
 #ifdef __APPLE__
     #include "SDL2/SDL.h"
     #include "SDL2/SDL_events.h"
@@ -34,6 +36,9 @@
 #include "Renderer.hpp"
 #include "Scene.hpp"
 #include "Template.hpp"
+#include "ResourceWatcher.hpp"
+#include "SceneSnapshot.hpp"
+#include "AssetGraph.hpp"
 
 
 #define IN_GAME_CELL_SIZE 100
@@ -52,6 +57,7 @@ public:
     bool isInTemplates(const std::string& templateName) const;
     void addTemplate(const std::string& templateName, const Template& newTemplate);
     Template& getTemplate(const std::string& templateName);
+    void pruneTemplates(const std::unordered_set<std::string>& inUse);
     rapidjson::Document gameConfig;
     enum class GameState {
         NoState,
@@ -73,7 +79,25 @@ public:
     void setGoodImage(std::string goodImage);
     
     void setPlayerSpeed(double speed);
+    void setHotReload(bool enabled);
+    void setSnapshots(bool enabled);
+    void setMusicSettings(uintmax_t streamingThreshold, int crossfadeMilliseconds);
+    void setVoiceSettings(const VoiceSettings& settings);
+    void setAssetPrefetch(bool enabled);
+    void setStartupReport(bool enabled);
 private:
+    void advanceAnimations();
+    // hot reload: applies whatever changed under resources/ since last frame to the running game
+    void applyResourceChanges(Scene& scene);
+    // deletes currScene and loads sceneStr in its place
+    Scene* changeScene(Scene* currScene, const std::string& sceneStr);
+    SceneSnapshot captureSnapshot(Scene& scene);
+    // loads the snapshot's scene first if it isn't the current one
+    bool restoreSnapshot(Scene*& currScene, const SceneSnapshot& snapshot);
+    // F5 quick-saves, F9 goes back to the quick-save, F8 restarts the scene; true once something was restored
+    bool handleSnapshotKeys(Scene*& currScene);
+    // decodes everything the scene (and, at startup, game.config) uses before it's loaded
+    PrefetchStats prefetchScene(const std::string& scenePath, bool withConfig);
     int health = 3;
     int score = 0;
     std::stringstream ss;
@@ -97,6 +121,14 @@ private:
     std::string scoreAudio = "";
     std::string damageAudio = "";
     std::string stepAudio = "";
+    bool hotReload = false;
+    ResourceWatcher resourceWatcher;
+    bool snapshots = false;
+    SceneSnapshot quickSave;
+    SceneSnapshot sceneStart; // taken as each scene finishes loading
+    AssetGraph assetGraph;
+    bool assetPrefetch = true;
+    bool startupReport = false;
 };
 
 #endif /* Engine_hpp */
@@ -0,0 +1,179 @@
+//
+//  FrameCapture.cpp
+//  game_engine
+//
+
+#include "FrameCapture.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <filesystem>
+#include <algorithm>
+#ifdef __APPLE__
+    #include "SDL2_image/SDL_image.h"
+#else
+    #include "SDL_image.h"
+#endif
+
+FrameCapture::~FrameCapture() {
+    stop();
+}
+
+void FrameCapture::configure(CaptureFormat format_in, const std::string& path_in, int bufferCount_in) {
+    format = format_in;
+    path = path_in;
+    bufferCount = std::max(1, bufferCount_in);
+}
+
+void FrameCapture::start(int width_in, int height_in) {
+    if (format == CaptureFormat::None || running) return;
+    width = width_in;
+    height = height_in;
+
+    if (format == CaptureFormat::PNG) {
+        std::filesystem::create_directories(path);
+    }
+    else {
+        video.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!video.is_open()) {
+            std::cerr << "Unable to open capture file " << path << std::endl;
+            return;
+        }
+        // frame rate is nominal, frames are written as they were presented
+        video << "YUV4MPEG2 W" << width << " H" << height << " F60:1 Ip A1:1 C420jpeg\n";
+    }
+
+    // every buffer is allocated up front so grabbing a frame never allocates
+    slots.resize(bufferCount);
+    for (int i = 0; i < bufferCount; ++i) {
+        slots[i].pixels.resize(static_cast<size_t>(width) * height * 3);
+        freeSlots.push_back(i);
+    }
+    running = true;
+    writer = std::thread(&FrameCapture::run, this);
+}
+
+void FrameCapture::grab(SDL_Renderer* renderer, int frameNumber) {
+    int slotIndex;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (freeSlots.empty()) {
+            framesDropped++;
+            return;
+        }
+        slotIndex = freeSlots.front();
+        freeSlots.pop_front();
+    }
+
+    // read back the whole output, not the zoomed viewport
+    float scaleX, scaleY;
+    SDL_RenderGetScale(renderer, &scaleX, &scaleY);
+    SDL_RenderSetScale(renderer, 1.0f, 1.0f);
+    Slot& slot = slots[slotIndex];
+    slot.frameNumber = frameNumber;
+    int result = SDL_RenderReadPixels(renderer, nullptr, SDL_PIXELFORMAT_RGB24, slot.pixels.data(), width * 3);
+    SDL_RenderSetScale(renderer, scaleX, scaleY);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (result != 0) {
+        std::cerr << "Unable to read back frame " << frameNumber << ". SDL_Error: " << SDL_GetError() << std::endl;
+        freeSlots.push_back(slotIndex);
+        return;
+    }
+    readySlots.push_back(slotIndex);
+    cv.notify_all();
+}
+
+void FrameCapture::stop() {
+    if (!running) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    cv.notify_all();
+    writer.join();
+    video.close();
+    std::cout << "capture: " << framesWritten << " frames written, " << framesDropped << " dropped" << std::endl;
+}
+
+bool FrameCapture::isActive() const {
+    return running;
+}
+
+bool FrameCapture::formatFromName(const std::string& name, CaptureFormat& format) {
+    if (name == "") format = CaptureFormat::None;
+    else if (name == "png") format = CaptureFormat::PNG;
+    else if (name == "y4m") format = CaptureFormat::Y4M;
+    else return false;
+    return true;
+}
+
+void FrameCapture::run() {
+    while (true) {
+        int slotIndex;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this] { return !readySlots.empty() || !running; });
+            if (readySlots.empty()) break; // stopped and everything is written
+            slotIndex = readySlots.front();
+            readySlots.pop_front();
+        }
+        if (format == CaptureFormat::PNG) {
+            writePNG(slots[slotIndex]);
+        }
+        else {
+            writeY4M(slots[slotIndex]);
+        }
+        framesWritten++;
+        std::lock_guard<std::mutex> lock(mutex);
+        freeSlots.push_back(slotIndex);
+    }
+}
+
+void FrameCapture::writePNG(const Slot& slot) {
+    std::ostringstream name;
+    name << path << "/frame_" << std::setw(6) << std::setfill('0') << slot.frameNumber << ".png";
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom(const_cast<Uint8*>(slot.pixels.data()), width, height, 24, width * 3, SDL_PIXELFORMAT_RGB24);
+    if (!surface || IMG_SavePNG(surface, name.str().c_str()) != 0) {
+        std::cerr << "Unable to save frame " << name.str() << ". SDL_image Error: " << IMG_GetError() << std::endl;
+    }
+    SDL_FreeSurface(surface);
+}
+
+void FrameCapture::writeY4M(const Slot& slot) {
+    // full range BT.601 4:2:0, chroma is the average of each 2x2 block
+    int chromaWidth = (width + 1) / 2;
+    int chromaHeight = (height + 1) / 2;
+    yuv.resize(static_cast<size_t>(width) * height + static_cast<size_t>(chromaWidth) * chromaHeight * 2);
+    Uint8* yPlane = yuv.data();
+    Uint8* uPlane = yPlane + static_cast<size_t>(width) * height;
+    Uint8* vPlane = uPlane + static_cast<size_t>(chromaWidth) * chromaHeight;
+    const Uint8* rgb = slot.pixels.data();
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const Uint8* pixel = rgb + (static_cast<size_t>(y) * width + x) * 3;
+            yPlane[y * width + x] = static_cast<Uint8>((77 * pixel[0] + 150 * pixel[1] + 29 * pixel[2]) >> 8);
+        }
+    }
+    for (int cy = 0; cy < chromaHeight; ++cy) {
+        for (int cx = 0; cx < chromaWidth; ++cx) {
+            int r = 0, g = 0, b = 0;
+            for (int dy = 0; dy < 2; ++dy) {
+                for (int dx = 0; dx < 2; ++dx) {
+                    int x = std::min(cx * 2 + dx, width - 1);
+                    int y = std::min(cy * 2 + dy, height - 1);
+                    const Uint8* pixel = rgb + (static_cast<size_t>(y) * width + x) * 3;
+                    r += pixel[0];
+                    g += pixel[1];
+                    b += pixel[2];
+                }
+            }
+            r /= 4; g /= 4; b /= 4;
+            uPlane[cy * chromaWidth + cx] = static_cast<Uint8>(std::clamp(((-43 * r - 85 * g + 128 * b) >> 8) + 128, 0, 255));
+            vPlane[cy * chromaWidth + cx] = static_cast<Uint8>(std::clamp(((128 * r - 107 * g - 21 * b) >> 8) + 128, 0, 255));
+        }
+    }
+    video << "FRAME\n";
+    video.write(reinterpret_cast<const char*>(yuv.data()), yuv.size());
+}
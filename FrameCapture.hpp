@@ -0,0 +1,69 @@
+//
+//  FrameCapture.hpp
+//  game_engine
+//
+
+#ifndef FrameCapture_hpp
+#define FrameCapture_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <fstream>
+#ifdef __APPLE__
+    #include "SDL2/SDL.h"
+#else
+    #include "SDL.h"
+#endif
+
+enum class CaptureFormat {
+    None,
+    PNG,    // one numbered png per frame in a directory
+    Y4M     // a single raw yuv4mpeg2 video file
+};
+
+// reads finished frames back into a ring of preallocated buffers and writes them out on a background thread
+// when the writer falls behind and every buffer is in use the frame is dropped instead of waiting
+class FrameCapture {
+public:
+    ~FrameCapture();
+    void configure(CaptureFormat format, const std::string& path, int bufferCount);
+    void start(int width, int height);
+    // call on the thread that owns the renderer, after drawing and before presenting
+    void grab(SDL_Renderer* renderer, int frameNumber);
+    // writes out every frame still queued
+    void stop();
+    bool isActive() const;
+    static bool formatFromName(const std::string& name, CaptureFormat& format);
+private:
+    struct Slot {
+        std::vector<Uint8> pixels; // RGB24, width * 3 bytes per row
+        int frameNumber = 0;
+    };
+    void run();
+    void writePNG(const Slot& slot);
+    void writeY4M(const Slot& slot);
+
+    CaptureFormat format = CaptureFormat::None;
+    std::string path = "";
+    int bufferCount = 4;
+    int width = 0;
+    int height = 0;
+    std::vector<Slot> slots;
+    std::deque<int> freeSlots;
+    std::deque<int> readySlots;
+    std::vector<Uint8> yuv; // writer thread only
+    std::ofstream video;
+    std::thread writer;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool running = false;
+    int framesWritten = 0;
+    int framesDropped = 0;
+};
+
+#endif /* FrameCapture_hpp */
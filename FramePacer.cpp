@@ -0,0 +1,106 @@
+//
+//  FramePacer.cpp
+//  game_engine
+//
+
+#include "FramePacer.hpp"
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+#include <iomanip>
+
+// frames per statistics window, about two seconds at 60 fps
+#define PACING_WINDOW 120
+// SDL_Delay can oversleep by a scheduler tick, the last stretch is spun instead
+#define PACING_SPIN_MS 2
+
+void FramePacer::configure(PacingMode mode_in, int targetFPS) {
+    mode = mode_in;
+    period = SDL_GetPerformanceFrequency() / std::max(1, targetFPS);
+    nextDeadline = 0;
+}
+
+PacingMode FramePacer::getMode() const {
+    return mode;
+}
+
+void FramePacer::setLogPath(const std::string& path) {
+    logPath = path;
+}
+
+void FramePacer::beginPresent() {
+    presentStart = SDL_GetPerformanceCounter();
+}
+
+void FramePacer::endPresent(int frameNumber) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    presentTimes.push_back(toMilliseconds(now - presentStart));
+    if (lastPresentEnd != 0) {
+        frameTimes.push_back(toMilliseconds(now - lastPresentEnd));
+    }
+    lastPresentEnd = now;
+    if (static_cast<int>(presentTimes.size()) < PACING_WINDOW || frameTimes.empty()) return;
+
+    Summary frame = summarize(frameTimes);
+    Summary present = summarize(presentTimes);
+    std::ostringstream frameLine;
+    std::ostringstream presentLine;
+    frameLine << std::fixed << std::setprecision(2) << "frame ms min " << frame.min << " avg " << frame.avg << " p99 " << frame.p99;
+    presentLine << std::fixed << std::setprecision(2) << "present ms min " << present.min << " avg " << present.avg << " p99 " << present.p99;
+    {
+        std::lock_guard<std::mutex> lock(summaryMutex);
+        summaryLines = {frameLine.str(), presentLine.str()};
+    }
+    if (logPath != "") {
+        if (!log.is_open()) {
+            log.open(logPath, std::ios::out | std::ios::trunc);
+        }
+        log << "frames " << frameNumber - PACING_WINDOW + 1 << "-" << frameNumber << ": " << frameLine.str() << ", " << presentLine.str() << '\n';
+    }
+    frameTimes.clear();
+    presentTimes.clear();
+}
+
+void FramePacer::waitForNextFrame() {
+    if (mode != PacingMode::TargetFPS) return;
+    Uint64 now = SDL_GetPerformanceCounter();
+    // first frame, or so far behind that catching up would mean a burst of unpaced frames
+    if (nextDeadline == 0 || now > nextDeadline + period) {
+        nextDeadline = now + period;
+        return;
+    }
+    Uint64 spinTicks = SDL_GetPerformanceFrequency() * PACING_SPIN_MS / 1000;
+    if (nextDeadline > now + spinTicks) {
+        SDL_Delay(static_cast<Uint32>((nextDeadline - now - spinTicks) * 1000 / SDL_GetPerformanceFrequency()));
+    }
+    while (SDL_GetPerformanceCounter() < nextDeadline) {
+        // spin
+    }
+    nextDeadline += period;
+}
+
+std::vector<std::string> FramePacer::getSummaryLines() {
+    std::lock_guard<std::mutex> lock(summaryMutex);
+    return summaryLines;
+}
+
+bool FramePacer::modeFromName(const std::string& name, PacingMode& mode) {
+    if (name == "vsync") mode = PacingMode::VSync;
+    else if (name == "uncapped") mode = PacingMode::Uncapped;
+    else if (name == "target") mode = PacingMode::TargetFPS;
+    else return false;
+    return true;
+}
+
+FramePacer::Summary FramePacer::summarize(std::vector<double>& samples) {
+    Summary summary;
+    std::sort(samples.begin(), samples.end());
+    summary.min = samples.front();
+    summary.avg = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    summary.p99 = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+    return summary;
+}
+
+double FramePacer::toMilliseconds(Uint64 ticks) const {
+    return static_cast<double>(ticks) * 1000.0 / SDL_GetPerformanceFrequency();
+}
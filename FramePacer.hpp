@@ -0,0 +1,62 @@
+//
+//  FramePacer.hpp
+//  game_engine
+//
+
+#ifndef FramePacer_hpp
+#define FramePacer_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <fstream>
+#ifdef __APPLE__
+    #include "SDL2/SDL.h"
+#else
+    #include "SDL.h"
+#endif
+
+enum class PacingMode {
+    VSync,      // present waits for the display
+    Uncapped,   // as fast as possible
+    TargetFPS   // software limiter, sleeps most of the wait then spins the rest
+};
+
+// paces presents and keeps frame/present time statistics over a window of frames
+// everything except getSummaryLines runs on the thread that presents
+class FramePacer {
+public:
+    void configure(PacingMode mode, int targetFPS);
+    PacingMode getMode() const;
+    void setLogPath(const std::string& path);
+    void beginPresent();
+    void endPresent(int frameNumber);
+    // only waits in TargetFPS mode
+    void waitForNextFrame();
+    // min/avg/p99 of the last full window, empty until one has been measured
+    std::vector<std::string> getSummaryLines();
+    static bool modeFromName(const std::string& name, PacingMode& mode);
+private:
+    struct Summary {
+        double min = 0.0;
+        double avg = 0.0;
+        double p99 = 0.0;
+    };
+    static Summary summarize(std::vector<double>& samples);
+    double toMilliseconds(Uint64 ticks) const;
+
+    PacingMode mode = PacingMode::VSync;
+    Uint64 period = 0;         // performance counter ticks per frame in TargetFPS mode
+    Uint64 nextDeadline = 0;
+    Uint64 presentStart = 0;
+    Uint64 lastPresentEnd = 0;
+    std::vector<double> frameTimes;    // milliseconds, this window
+    std::vector<double> presentTimes;
+    std::string logPath = "";
+    std::ofstream log;
+    std::mutex summaryMutex;
+    std::vector<std::string> summaryLines;
+};
+
+#endif /* FramePacer_hpp */
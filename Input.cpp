@@ -11,49 +11,54 @@
 #include "Renderer.hpp"
 #include "Camera.hpp"
 #include "IntroHandler.hpp"
-#include "rapidjson/filereadstream.h"
+#include "JsonFile.hpp"
+#include "SceneStreamReader.hpp"
+#include "ThreadPool.hpp"
+#include "ResourceManifest.hpp"
+#include "WorldStreamer.hpp"
+#include "LoadProfiler.hpp"
 #include <unordered_map>
 #include <iostream>
 #include <vector>
 #include <typeinfo>
 #include <optional>
+#include <unordered_set>
+#include <algorithm>
 
+// scene files at least this large are streamed actor by actor instead of parsed into a DOM
+uintmax_t Input::sceneStreamingThreshold = 16 * 1024 * 1024;
+// scenes with fewer actors than this aren't worth handing to the thread pool
+#define PARALLEL_ACTOR_MIN 256
+bool Input::parallelActorConstruction = true;
+bool Input::hotReload = false;
 
-void Input::ReadJsonFile(const std::string& path, rapidjson::Document & out_document)
-{
-    FILE* file_pointer = nullptr;
-    #ifdef _WIN32
-    fopen_s(&file_pointer, path.c_str(), "rb");
-    #else
-    file_pointer = fopen(path.c_str(), "rb");
-    #endif
-    char buffer[65536];
-    rapidjson::FileReadStream stream(file_pointer, buffer, sizeof(buffer));
-    out_document.ParseStream(stream);
-    std::fclose(file_pointer);
-
-    if (out_document.HasParseError()) {
-        rapidjson::ParseErrorCode errorCode = out_document.GetParseError();
-        std::cout << "error parsing json at [" << path << "]" << std::endl;
-        exit(0);
-    }
-}
 
 void Input::checkResourcesDirectory() {
+    // a packed build ships resources.pak next to (or instead of) the resources directory
+    bool packMounted = std::filesystem::exists("resources.pak") && ResourceManifest::mountPack("resources.pak");
+    
     // check if the resources directory exists
-    if (!std::filesystem::exists("resources")) {
+    if (!packMounted && !std::filesystem::exists("resources")) {
         // print error message and exit
         std::cout << "error: resources/ missing";
         exit(0);
     }
     
+    // everything else is looked up in the manifest instead of probing the disk
+    ResourceManifest::scan("resources");
+    
     // check if the resources/game.config file exists
-    if (!std::filesystem::exists("resources/game.config")) {
+    if (!ResourceManifest::contains(ResourceType::Config, "game.config")) {
         std::cout << "error: resources/game.config missing";
         exit(0);
     }
 }
 
+void Input::readLoadProfileConfig(const rapidjson::Document& document) {
+    // a per asset and per phase report on every scene load, appended to load_profile_path as json lines
+    LoadProfiler::configure(readBoolFromJSON(document, "load_profile", false), readStringFromJSON(document, "load_profile_path", "load_profile.jsonl"));
+}
+
 void Input::readGameFile(Renderer& window, IntroHandler& intro, Engine& engine, const rapidjson::Document& document) {
 
     // get game title for window
@@ -64,19 +69,19 @@ void Input::readGameFile(Renderer& window, IntroHandler& intro, Engine& engine,
     std::string fontName = "";
     if (document.HasMember("font") && document["font"].IsString()) {
         fontName = document["font"].GetString();
-        std::string fontPath = "resources/fonts/" + fontName + ".ttf";
-        if (!std::filesystem::exists(fontPath)) {
+        std::optional<ResourceEntry> fontEntry = ResourceManifest::find(ResourceType::Font, fontName);
+        if (!fontEntry.has_value()) {
             std::cout << "error: font " << fontName << " missing";
             exit(0);
         }
-        window.setFont(LoadFont(fontPath));
+        std::chrono::steady_clock::time_point fontStart = std::chrono::steady_clock::now();
+        window.setFont(LoadFont(ResourceManifest::open(*fontEntry)));
+        LoadProfiler::recordAsset(AssetKind::Font, fontName, fontEntry->size, LoadProfiler::millisecondsSince(fontStart), false);
     }
     // ending sequence vars
     if (document.HasMember("game_over_good_audio") && document["game_over_good_audio"].IsString()) {
         std::string goodAudio = document["game_over_good_audio"].GetString();
-        std::string imgPathWAV = "resources/audio/" + goodAudio + ".wav";
-        std::string imgPathOGG = "resources/audio/" + goodAudio + ".ogg";
-        if (!std::filesystem::exists(imgPathWAV) && !std::filesystem::exists(imgPathOGG)) {
+        if (!ResourceManifest::contains(ResourceType::Audio, goodAudio)) {
             exit(0);
         }
         engine.setGoodAudio(goodAudio);
@@ -84,9 +89,7 @@ void Input::readGameFile(Renderer& window, IntroHandler& intro, Engine& engine,
     
     if (document.HasMember("game_over_bad_audio") && document["game_over_bad_audio"].IsString()) {
         std::string badAudio = document["game_over_bad_audio"].GetString();
-        std::string imgPathWAV = "resources/audio/" + badAudio + ".wav";
-        std::string imgPathOGG = "resources/audio/" + badAudio + ".ogg";
-        if (!std::filesystem::exists(imgPathWAV) && !std::filesystem::exists(imgPathOGG)) {
+        if (!ResourceManifest::contains(ResourceType::Audio, badAudio)) {
             exit(0);
         }
         engine.setBadAudio(badAudio);
@@ -99,6 +102,25 @@ void Input::readGameFile(Renderer& window, IntroHandler& intro, Engine& engine,
     engine.setPlayerSpeed(speed);
     
     engine.setScoreSFX(loadInAudio(document, "score_sfx"));
+    readVoiceSettings(document, engine);
+    // music files this big or bigger stream as they play instead of being decoded whole, 0 streams every track
+    double musicStreamingThresholdMB = readDoubleFromJSON(document, "music_streaming_threshold_mb", 1.0);
+    engine.setMusicSettings(static_cast<uintmax_t>(std::max(musicStreamingThresholdMB, 0.0) * 1024 * 1024),
+                            readIntFromJSON(document, "music_crossfade_ms", 0));
+    
+    // 0 streams every scene
+    double streamingThresholdMB = readDoubleFromJSON(document, "scene_streaming_threshold_mb", 16.0);
+    sceneStreamingThreshold = static_cast<uintmax_t>(std::max(streamingThresholdMB, 0.0) * 1024 * 1024);
+    parallelActorConstruction = readBoolFromJSON(document, "parallel_actor_construction", true);
+    ResourceManifest::setRescanOnMiss(readBoolFromJSON(document, "resource_rescan_on_miss", false));
+    // dev mode: edits under resources/ are picked up while the game runs
+    hotReload = readBoolFromJSON(document, "hot_reload", false);
+    engine.setHotReload(hotReload);
+    // F5/F9 quick-save and load, F8 restarts the scene
+    engine.setSnapshots(readBoolFromJSON(document, "quick_save", false));
+    // decode a scene's images and audio in parallel before it loads, and say how long startup took
+    engine.setAssetPrefetch(readBoolFromJSON(document, "asset_prefetch", true));
+    engine.setStartupReport(readBoolFromJSON(document, "startup_report", false));
     
     // load in intro images if exist
     std::vector<std::string> temp_img = readStringArrayFromJSON(document, "intro_image");
@@ -130,9 +152,7 @@ void Input::readGameFile(Renderer& window, IntroHandler& intro, Engine& engine,
 std::string Input::loadInAudio(const rapidjson::Document& document, const std::string audio_property){
     if (document.HasMember(audio_property.c_str()) && document[audio_property.c_str()].IsString()) {
         std::string sound_effect = document[audio_property.c_str()].GetString();
-        std::string imgPathWAV = "resources/audio/" + sound_effect + ".wav";
-        std::string imgPathOGG = "resources/audio/" + sound_effect + ".ogg";
-        if (!std::filesystem::exists(imgPathWAV) && !std::filesystem::exists(imgPathOGG)) {
+        if (!ResourceManifest::contains(ResourceType::Audio, sound_effect)) {
             exit(0);
         }
         return sound_effect;
@@ -169,19 +189,56 @@ std::string Input::getHPImg(rapidjson::Document& document){
 
 
 void Input::readRenderFile(Renderer& renderer, Camera& camera) {
-    rapidjson::Document document;
     std::string path = "resources/rendering.config";
     
     // if file doesn't exist, exit and use default values
-    if (!std::filesystem::exists(path)) {
+    if (!ResourceManifest::exists(path)) {
         return;
     }
 
-    ReadJsonFile(path, document);
+    JsonFile renderFile(path);
+    const rapidjson::Document& document = renderFile.getDocument();
     
     renderer.setWidth(readIntFromJSON(document, "x_resolution", 640));
     renderer.setHeight(readIntFromJSON(document, "y_resolution", 360));
     renderer.setMovementFlip(readBoolFromJSON(document, "x_scale_actor_flipping_on_movement", false));
+    // 0 means no texture budget, unreferenced textures are then only dropped on scene transitions
+    renderer.setTextureBudget(static_cast<size_t>(readIntFromJSON(document, "texture_budget_mb", 0)) * 1024 * 1024);
+    renderer.setTextureReport(readBoolFromJSON(document, "texture_cache_report", false));
+    // draw on a dedicated thread so simulating the next frame overlaps drawing this one
+    renderer.setRenderThread(readBoolFromJSON(document, "render_thread", false));
+    // actors that never move with a render_order below this are baked into chunk textures at scene load
+    if (document.HasMember("static_layer_render_order") && document["static_layer_render_order"].IsInt()) {
+        renderer.setStaticLayer(document["static_layer_render_order"].GetInt(), readIntFromJSON(document, "static_layer_chunk_size", 1024));
+    }
+    // don't redraw or present frames whose content hasn't changed (intro, ending screens)
+    // off by default since scripted input is replayed by presented frame number
+    renderer.setSkipUnchangedFrames(readBoolFromJSON(document, "skip_unchanged_frames", false));
+    // vsync, uncapped or target (target_fps with a sleep then spin limiter)
+    PacingMode pacingMode;
+    std::string pacingName = readStringFromJSON(document, "frame_pacing", "vsync");
+    if (!FramePacer::modeFromName(pacingName, pacingMode)) {
+        std::cout << "error: unknown frame_pacing " << pacingName;
+        exit(0);
+    }
+    renderer.getFramePacer().configure(pacingMode, readIntFromJSON(document, "target_fps", 60));
+    renderer.getFramePacer().setLogPath(readStringFromJSON(document, "frame_stats_log", ""));
+    renderer.setFrameStatsOverlay(readBoolFromJSON(document, "frame_stats_overlay", false));
+    // collider, trigger, contact and chunk outlines, F1 toggles it in game
+    renderer.setDebugOverlay(readBoolFromJSON(document, "debug_overlay", false));
+    // software backend: fixed resolution cpu rendering with per frame hashes and optional png dumps
+    renderer.setSoftwareRender(readBoolFromJSON(document, "software_render", false));
+    renderer.getSoftwareBackend().setHashLogPath(readStringFromJSON(document, "frame_hash_log", "frame_hashes.log"));
+    renderer.getSoftwareBackend().setDumpDirectory(readStringFromJSON(document, "frame_dump_dir", ""));
+    // record gameplay as a png sequence or a y4m video, frames are dropped rather than slowing the game down
+    CaptureFormat captureFormat;
+    std::string captureName = readStringFromJSON(document, "capture_format", "");
+    if (!FrameCapture::formatFromName(captureName, captureFormat)) {
+        std::cout << "error: unknown capture_format " << captureName;
+        exit(0);
+    }
+    std::string defaultCapturePath = captureFormat == CaptureFormat::Y4M ? "capture.y4m" : "capture";
+    renderer.getFrameCapture().configure(captureFormat, readStringFromJSON(document, "capture_path", defaultCapturePath), readIntFromJSON(document, "capture_buffers", 4));
     
     camera.setWidth(readIntFromJSON(document, "x_resolution", 640));
     camera.setHeight(readIntFromJSON(document, "y_resolution", 360));
@@ -213,236 +270,718 @@ std::string Input::getInitialScene(const rapidjson::Document& document) {
 void Input::findScene(std::string scenePath) {
     // determine if scene exists
     std::string sceneName = extractSceneName(scenePath);
-    if (!std::filesystem::exists(scenePath)) {
+    if (!ResourceManifest::exists(scenePath)) {
         std::cout << "error: scene " << sceneName << " is missing";
         exit(0);
     }
 }
 
 void Input::readScene(Scene& scene, Engine& engine, Renderer& renderer){
-    rapidjson::Document document;
-    ReadJsonFile(scene.getScenePath(), document);
+    // very large scenes are streamed so the whole DOM never has to sit next to the actors
+    std::optional<ResourceEntry> sceneEntry = ResourceManifest::findPath(scene.getScenePath());
+    if (sceneEntry.has_value() && sceneEntry->size >= sceneStreamingThreshold) {
+        readSceneStreaming(scene, engine, renderer);
+        return;
+    }
+
+    // the scene's strings are read straight out of the mapped file while the actors are built
+    std::chrono::steady_clock::time_point jsonStart = std::chrono::steady_clock::now();
+    JsonFile sceneFile(scene.getScenePath());
+    const rapidjson::Document& document = sceneFile.getDocument();
+    LoadProfiler::recordPhase("scene_json", LoadProfiler::millisecondsSince(jsonStart));
+    
+    // decode every image the scene and its new templates use up front, in parallel
+    {
+        LoadProfiler::PhaseTimer phase("image_preload");
+        renderer.PreloadImages(collectSceneImages(document, engine));
+    }
     
     std::vector<Actor>& actors = scene.getActors();
+    // images referenced directly by the scene are owned by it until the next scene transition
+    std::string textureOwner = scene.getScenePath();
     
-    // reserve space in vector for number of actors (+ 1 in case)
-    actors.reserve(document["actors"].Size());
-
-    // iterate over all actor json descs, create new objects and add to vector
-    for (auto& v: document["actors"].GetArray()) {
-        bool isPlayer = false;
-
-        // initialize all properties to default values
-        std::string name = "";
-        double x = 0;
-        double y = 0;
-        float vel_x = 0;
-        float vel_y = 0;
-        std::string nearby_dialogue = "";
-        std::string contact_dialogue = "";
-        SDL_Texture* view_image = nullptr;
-        SDL_Texture* view_image_back = nullptr;
-        SDL_Texture* view_image_damage = nullptr;
-        SDL_Texture* view_image_attack = nullptr;
-        double transform_scale_x = 1.0;
-        double transform_scale_y = 1.0;
-        double transform_rotation_degrees = 0.0;
-        std::optional<double> view_pivot_offset_x; // default is actor_view.w * 0.5
-        std::optional<double> view_pivot_offset_y;
-        std::optional<int> render_order;
-        bool bounce = false;
-        std::optional<float> collider_width;
-        std::optional<float> collider_height;
-        std::optional<float> trigger_width;
-        std::optional<float> trigger_height;
-        
-
-
-        // see if actor has a template
-        if (v.HasMember("template") && v["template"].IsString()) {
-		    std::string templateName = v["template"].GetString();
-            // Check if the template is already loaded
-            if (!engine.isInTemplates(templateName)) {
-                std::string templatePath = "resources/actor_templates/" + templateName + ".template";
-                // if the template file is missing, print error message and exit
-				if (!std::filesystem::exists(templatePath)) {
-					std::cout << "error: template " << templateName << " is missing";
-					exit(0);
-				}
-                // read the template file and add it to the engine
-                rapidjson::Document templateDoc;
-                Input::ReadJsonFile(templatePath, templateDoc);
-                Template newTemplate(templateDoc, renderer);
-				engine.addTemplate(templateName, newTemplate);
-            }
-            // get the template from the engine
-            Template& curr_template = engine.getTemplate(templateName);
-            // Apply properties from template
-            name = curr_template.name;
-            x = curr_template.x;
-            y = curr_template.y;
-            vel_x = curr_template.vel_x;
-            vel_y = curr_template.vel_y;
-            nearby_dialogue = curr_template.nearby_dialogue;
-            contact_dialogue = curr_template.contact_dialogue;
-            view_image = curr_template.view_image;
-            view_image_back = curr_template.view_image_back;
-            view_image_damage = curr_template.view_image_damage;
-            view_image_attack = curr_template.view_image_attack;
-            transform_scale_x = curr_template.transform_scale_x;
-            transform_scale_y = curr_template.transform_scale_y;
-            transform_rotation_degrees = curr_template.transform_rotation_degrees;
-            view_pivot_offset_x = curr_template.view_pivot_offset_x;
-            view_pivot_offset_y = curr_template.view_pivot_offset_y;
-            render_order = curr_template.render_order;
-            bounce = curr_template.bounce;
-            collider_width = curr_template.collider_width;
-            collider_height = curr_template.collider_height;
-            trigger_width = curr_template.trigger_width;
-            trigger_height = curr_template.trigger_height;
-            
-		} 
+    const rapidjson::Value& actorValues = document["actors"];
+    std::vector<ActorRecord> records;
+    std::chrono::steady_clock::time_point actorsStart = std::chrono::steady_clock::now();
+    if (parallelActorConstruction && actorValues.Size() >= PARALLEL_ACTOR_MIN) {
+        buildActorsParallel(actorValues, scene, engine, renderer, textureOwner, records);
+    }
+    else {
+        // reserve space in vector for number of actors (+ 1 in case)
+        actors.reserve(actorValues.Size());
+        records.reserve(actorValues.Size());
 
-        // override with actor-specific properties
-        if (v.HasMember("name") && v["name"].IsString()) name = v["name"].GetString();
-        //if (v.HasMember("view") && v["view"].IsString()) view = v["view"].GetString()[0];
-        if (v.HasMember("transform_position_x") && v["transform_position_x"].IsNumber()) x = v["transform_position_x"].GetDouble();
-        if (v.HasMember("transform_position_y") && v["transform_position_y"].IsNumber()) y = v["transform_position_y"].GetDouble();
-        if (v.HasMember("vel_x") && v["vel_x"].IsFloat()) vel_x = v["vel_x"].GetFloat();
-        if (v.HasMember("vel_y") && v["vel_y"].IsFloat()) vel_y = v["vel_y"].GetFloat();
-        if (v.HasMember("nearby_dialogue") && v["nearby_dialogue"].IsString()) nearby_dialogue = v["nearby_dialogue"].GetString();
-        if (v.HasMember("contact_dialogue") && v["contact_dialogue"].IsString()) contact_dialogue = v["contact_dialogue"].GetString();
-        if (v.HasMember("view_image") && v["view_image"].IsString()){
-            // load in actor image
-            view_image = renderer.getImagePointer(v["view_image"].GetString());
+        // iterate over all actor json descs, create new objects and add to vector
+        for (auto& v: actorValues.GetArray()) {
+            resolveTemplate(v, scene, engine, renderer);
+            records.emplace_back();
+            actors.push_back(buildActor(v, engine, renderer, textureOwner, records.back()));
         }
-        if (v.HasMember("view_image_back") && v["view_image_back"].IsString()){
-            // load in actor back image
-            view_image_back = renderer.getImagePointer(v["view_image_back"].GetString());
+    }
+    LoadProfiler::recordPhase("actors", LoadProfiler::millisecondsSince(actorsStart));
+    // pointers into actors are only handed out once the vector is done growing
+    {
+        LoadProfiler::PhaseTimer phase("register");
+        registerActors(scene, engine, actors, records);
+    }
+    readSceneEmitters(document, scene, renderer, textureOwner);
+    readWorldChunks(document, scene, renderer);
+    if (hotReload) {
+        for (auto& v : actorValues.GetArray()) {
+            scene.getActorSourceHashes().push_back(hashValue(v));
         }
-        if (v.HasMember("view_image_damage") && v["view_image_damage"].IsString()){
-            // load in actor damaged
-            view_image_damage = renderer.getImagePointer(v["view_image_damage"].GetString());
+        scene.getActorRecords() = std::move(records);
+    }
+}
+
+void Input::buildActorsParallel(const rapidjson::Value& actorValues, Scene& scene, Engine& engine, Renderer& renderer, const std::string& textureOwner, std::vector<ActorRecord>& records){
+    std::vector<Actor>& actors = scene.getActors();
+    size_t actorCount = actorValues.Size();
+    
+    // anything with side effects happens here first, in scene order: templates load and images get their owner
+    // after this the workers only read the templates and hit the texture cache
+    std::vector<std::string> imageNames;
+    for (auto& v : actorValues.GetArray()) {
+        resolveTemplate(v, scene, engine, renderer);
+        validateActor(v);
+        collectImageProperties(v, imageNames);
+    }
+    std::unordered_set<std::string> seenImages;
+    for (const std::string& imageName : imageNames) {
+        if (seenImages.insert(imageName).second) {
+            renderer.getImagePointer(imageName, textureOwner);
         }
-        if (v.HasMember("view_image_attack") && v["view_image_attack"].IsString()){
-            // load in actor attacked img
-            view_image_attack = renderer.getImagePointer(v["view_image_attack"].GetString());
+    }
+    
+    // the placeholder slots take the same ids the serial loader would have handed out, in order
+    size_t first = actors.size();
+    int firstID = g_uuid;
+    actors.resize(first + actorCount);
+    records.resize(actorCount);
+    ThreadPool::shared().parallelFor(actorCount, [&](size_t i) {
+        actors[first + i] = buildActor(actorValues[static_cast<rapidjson::SizeType>(i)], engine, renderer, textureOwner, records[i], firstID + static_cast<int>(i));
+    });
+}
+
+void Input::readSceneStreaming(Scene& scene, Engine& engine, Renderer& renderer){
+    std::vector<Actor>& actors = scene.getActors();
+    std::string textureOwner = scene.getScenePath();
+    std::vector<ActorRecord> records;
+    // images are decoded as actors ask for them, there is no DOM to collect them from up front
+    std::chrono::steady_clock::time_point actorsStart = std::chrono::steady_clock::now();
+    SceneStreamReader reader(scene.getScenePath());
+    bool parsed = reader.read(
+        [&](size_t actorCount) {
+            actors.reserve(actorCount);
+            records.reserve(actorCount);
+        },
+        [&](const rapidjson::Value& v) {
+            if (!v.IsObject()) {
+                std::cout << "error parsing json at [" << scene.getScenePath() << "]" << std::endl;
+                exit(0);
+            }
+            resolveTemplate(v, scene, engine, renderer);
+            records.emplace_back();
+            actors.push_back(buildActor(v, engine, renderer, textureOwner, records.back()));
+            if (hotReload) {
+                scene.getActorSourceHashes().push_back(hashValue(v));
+            }
+        });
+    if (!parsed) {
+        std::cout << "error parsing json at [" << scene.getScenePath() << "]" << std::endl;
+        exit(0);
+    }
+    // parsing and building are interleaved, so the whole stream counts as actor construction
+    LoadProfiler::recordPhase("actors", LoadProfiler::millisecondsSince(actorsStart));
+    {
+        LoadProfiler::PhaseTimer phase("register");
+        registerActors(scene, engine, actors, records);
+    }
+    readSceneEmitters(reader.getSceneValues(), scene, renderer, textureOwner);
+    readWorldChunks(reader.getSceneValues(), scene, renderer);
+    if (hotReload) {
+        scene.getActorRecords() = std::move(records);
+    }
+}
+
+bool Input::parseForReload(const std::string& path, rapidjson::Document& document){
+    // a half finished edit shouldn't take the game down, the running version stays until the file parses
+    if (!ResourceManifest::exists(path)) return false;
+    JsonFile file(path, false);
+    document.Parse(file.getText());
+    if (document.HasParseError() || !document.IsObject()) {
+        std::cout << "hot reload: couldn't parse " << path << ", keeping the running version" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool Input::reloadTemplate(const std::string& templateName, Engine& engine, Renderer& renderer){
+    std::optional<ResourceEntry> templateEntry = ResourceManifest::find(ResourceType::Template, templateName);
+    rapidjson::Document document;
+    if (!templateEntry.has_value() || !parseForReload(templateEntry->path, document)) return false;
+    // assigned over the old one, so the animation set actors point at stays where it is
+    Template newTemplate(document, renderer, templateName);
+    engine.addTemplate(templateName, newTemplate);
+    return true;
+}
+
+void Input::patchScene(Scene& scene, Engine& engine, Renderer& renderer, const std::unordered_set<std::string>& changedTemplates, bool rebuildAll){
+    rapidjson::Document document;
+    if (!parseForReload(scene.getScenePath(), document)) return;
+    if (!document.HasMember("actors") || !document["actors"].IsArray()) {
+        std::cout << "hot reload: " << scene.getScenePath() << " has no actors, keeping the running version" << std::endl;
+        return;
+    }
+    renderer.PreloadImages(collectSceneImages(document, engine));
+    
+    const rapidjson::Value& actorValues = document["actors"];
+    std::vector<Actor>& actors = scene.getActors();
+    std::vector<uint64_t>& hashes = scene.getActorSourceHashes();
+    std::vector<ActorRecord>& records = scene.getActorRecords();
+    std::string textureOwner = scene.getScenePath();
+    // the player is matched by name rather than by its place in the file, copied before anything moves
+    std::optional<Actor> playerBefore;
+    if (scene.getPlayer()) {
+        playerBefore = *scene.getPlayer();
+    }
+    
+    // actors are matched to the running ones by index, an actor whose json didn't change is kept as it is
+    std::vector<Actor> patched;
+    std::vector<ActorRecord> patchedRecords;
+    std::vector<uint64_t> patchedHashes;
+    patched.reserve(actorValues.Size());
+    patchedRecords.reserve(actorValues.Size());
+    patchedHashes.reserve(actorValues.Size());
+    int kept = 0;
+    int rebuilt = 0;
+    for (rapidjson::SizeType i = 0; i < actorValues.Size(); ++i) {
+        const rapidjson::Value& v = actorValues[i];
+        resolveTemplate(v, scene, engine, renderer);
+        uint64_t hash = hashValue(v);
+        bool existed = i < actors.size() && i < hashes.size() && i < records.size();
+        bool sourceChanged = !existed || hashes[i] != hash;
+        bool templateChanged = rebuildAll || (v.HasMember("template") && v["template"].IsString() && changedTemplates.count(v["template"].GetString()) > 0);
+        patchedHashes.push_back(hash);
+        if (!sourceChanged && !templateChanged) {
+            patched.push_back(std::move(actors[i]));
+            patchedRecords.push_back(std::move(records[i]));
+            kept++;
+            continue;
         }
-        if (v.HasMember("transform_scale_x") && v["transform_scale_x"].IsNumber()){
-            transform_scale_x = v["transform_scale_x"].GetDouble();
+        patchedRecords.emplace_back();
+        std::optional<int> actorID;
+        if (existed) {
+            actorID = actors[i].getActorID();
         }
-        if (v.HasMember("transform_scale_y") && v["transform_scale_y"].IsNumber()){
-            transform_scale_y = v["transform_scale_y"].GetDouble();
+        Actor actor = buildActor(v, engine, renderer, textureOwner, patchedRecords.back(), actorID);
+        if (!sourceChanged) {
+            // only its template changed, it carries on from where it was
+            actor.takeRuntimeState(actors[i]);
         }
-        if (v.HasMember("transform_rotation_degrees") && v["transform_rotation_degrees"].IsNumber()){
-            transform_rotation_degrees = v["transform_rotation_degrees"].GetDouble();
+        else if (patchedRecords.back().isPlayer && playerBefore.has_value()) {
+            actor.takeRuntimeState(playerBefore.value());
         }
-        if (v.HasMember("view_pivot_offset_x") && v["view_pivot_offset_x"].IsNumber()){
-            view_pivot_offset_x = v["view_pivot_offset_x"].GetDouble();
+        patched.push_back(std::move(actor));
+        rebuilt++;
+    }
+    size_t removed = actors.size() > patched.size() ? actors.size() - patched.size() : 0;
+    
+    scene.clearActorLists();
+    actors.swap(patched);
+    registerActors(scene, engine, actors, patchedRecords);
+    readSceneEmitters(document, scene, renderer, textureOwner);
+    records = std::move(patchedRecords);
+    hashes = std::move(patchedHashes);
+    scene.rebakeStaticLayer(renderer);
+    scene.sortActorsByRenderOrder();
+    std::cout << "hot reload: " << scene.getScenePath() << " " << kept << " kept, " << rebuilt << " rebuilt, " << removed << " removed" << std::endl;
+}
+
+uint64_t Input::hashValue(const rapidjson::Value& value){
+    // FNV-1a over the value's structure and contents, member order included
+    uint64_t hash = 14695981039346656037ULL;
+    auto mix = [&hash](const void* bytes, size_t length) {
+        const unsigned char* data = static_cast<const unsigned char*>(bytes);
+        for (size_t i = 0; i < length; ++i) {
+            hash = (hash ^ data[i]) * 1099511628211ULL;
         }
-        if (v.HasMember("view_pivot_offset_y") && v["view_pivot_offset_y"].IsNumber()){
-            view_pivot_offset_y = v["view_pivot_offset_y"].GetDouble();
+    };
+    auto mixChild = [&mix](uint64_t childHash) {
+        mix(&childHash, sizeof(childHash));
+    };
+    int type = static_cast<int>(value.GetType());
+    mix(&type, sizeof(type));
+    if (value.IsString()) {
+        mix(value.GetString(), value.GetStringLength());
+    }
+    else if (value.IsNumber()) {
+        double number = value.GetDouble();
+        mix(&number, sizeof(number));
+    }
+    else if (value.IsArray()) {
+        for (auto& element : value.GetArray()) {
+            mixChild(hashValue(element));
         }
-        if (v.HasMember("render_order") && v["render_order"].IsNumber()){
-            render_order = v["render_order"].GetInt();
+    }
+    else if (value.IsObject()) {
+        for (auto it = value.MemberBegin(); it != value.MemberEnd(); ++it) {
+            mixChild(hashValue(it->name));
+            mixChild(hashValue(it->value));
         }
-        if (v.HasMember("movement_bounce_enabled") && v["movement_bounce_enabled"].IsBool()){
-            bounce =  v["movement_bounce_enabled"].GetBool();
+    }
+    return hash;
+}
+
+void Input::readSceneEmitters(const rapidjson::Value& document, Scene& scene, Renderer& renderer, const std::string& textureOwner){
+    // emitters placed in the world rather than on an actor
+    if (document.HasMember("particle_emitters") && document["particle_emitters"].IsArray()) {
+        std::vector<EmitterConfig> sceneEmitters;
+        readEmitters(document["particle_emitters"], renderer, textureOwner, sceneEmitters);
+        for (const EmitterConfig& emitterConfig : sceneEmitters) {
+            scene.getParticles().addEmitter(emitterConfig, nullptr);
         }
-        if (v.HasMember("box_collider_width") && v["box_collider_width"].IsNumber()) collider_width = v["box_collider_width"].GetFloat();
-        if (v.HasMember("box_collider_height") && v["box_collider_height"].IsNumber()) collider_height = v["box_collider_height"].GetFloat();
-        
-        if (v.HasMember("box_trigger_width") && v["box_trigger_width"].IsNumber()) trigger_width = v["box_trigger_width"].GetFloat();
-        if (v.HasMember("box_trigger_height") && v["box_trigger_height"].IsNumber()) trigger_height = v["box_trigger_height"].GetFloat();
-        
-        if (v.HasMember("damage_sfx") && v["damage_sfx"].IsString()) {
-            std::string sound_effect = v["damage_sfx"].GetString();
-            std::string imgPathWAV = "resources/audio/" + sound_effect + ".wav";
-            std::string imgPathOGG = "resources/audio/" + sound_effect + ".ogg";
-            if (!std::filesystem::exists(imgPathWAV) && !std::filesystem::exists(imgPathOGG)) {
+    }
+}
+
+void Input::readVoiceSettings(const rapidjson::Document& document, Engine& engine){
+    // priorities, instance limits and volumes per sound effect, and how many can start in one frame
+    VoiceSettings settings;
+    if (document.HasMember("voices") && document["voices"].IsObject()) {
+        const rapidjson::Value& voicesValue = document["voices"];
+        settings.maxNewPerFrame = static_cast<int>(readDoubleFromJSON(voicesValue, "max_new_per_frame", settings.maxNewPerFrame));
+        if (voicesValue.HasMember("stealing") && voicesValue["stealing"].IsString()) {
+            std::string stealingName = voicesValue["stealing"].GetString();
+            if (!VoiceManager::stealingFromName(stealingName, settings.stealing)) {
+                std::cout << "error: unknown voice stealing " << stealingName << ", expected oldest or quietest";
                 exit(0);
             }
-            engine.setDamageSFX(sound_effect);
         }
-        
-        if (v.HasMember("step_sfx") && v["step_sfx"].IsString()) {
-            std::string sound_effect = v["step_sfx"].GetString();
-            std::string imgPathWAV = "resources/audio/" + sound_effect + ".wav";
-            std::string imgPathOGG = "resources/audio/" + sound_effect + ".ogg";
-            if (!std::filesystem::exists(imgPathWAV) && !std::filesystem::exists(imgPathOGG)) {
-                exit(0);
+        if (voicesValue.HasMember("report") && voicesValue["report"].IsBool()) {
+            settings.report = voicesValue["report"].GetBool();
+        }
+        if (voicesValue.HasMember("sounds") && voicesValue["sounds"].IsObject()) {
+            for (auto& member : voicesValue["sounds"].GetObject()) {
+                if (!member.value.IsObject()) continue;
+                SoundSettings sound;
+                sound.priority = static_cast<int>(readDoubleFromJSON(member.value, "priority", sound.priority));
+                sound.maxInstances = static_cast<int>(readDoubleFromJSON(member.value, "max_instances", sound.maxInstances));
+                sound.volume = std::clamp(static_cast<int>(readDoubleFromJSON(member.value, "volume", sound.volume)), 0, MIX_MAX_VOLUME);
+                if (sound.maxInstances < 1) {
+                    std::cout << "error: max_instances for " << member.name.GetString() << " has to be at least 1";
+                    exit(0);
+                }
+                settings.sounds[member.name.GetString()] = sound;
             }
-            engine.setStepSFX(sound_effect);
         }
-        
-        std::string nearbyDialogueSFX = "";
-        if (v.HasMember("nearby_dialogue_sfx") && v["nearby_dialogue_sfx"].IsString()) {
-            std::string sound_effect = v["nearby_dialogue_sfx"].GetString();
-            std::string imgPathWAV = "resources/audio/" + sound_effect + ".wav";
-            std::string imgPathOGG = "resources/audio/" + sound_effect + ".ogg";
-            if (!std::filesystem::exists(imgPathWAV) && !std::filesystem::exists(imgPathOGG)) {
+    }
+    engine.setVoiceSettings(settings);
+}
+
+void Input::readWorldChunks(const rapidjson::Value& document, Scene& scene, Renderer& renderer){
+    // actors in the scene file are always loaded, chunk files next to it stream in around the camera
+    if (!document.HasMember("world_chunks") || !document["world_chunks"].IsObject()) return;
+    const rapidjson::Value& chunksValue = document["world_chunks"];
+    WorldChunkSettings settings;
+    settings.chunkSize = readFloatFromJSON(chunksValue, "chunk_size", settings.chunkSize);
+    settings.loadRadius = static_cast<int>(readDoubleFromJSON(chunksValue, "load_radius", settings.loadRadius));
+    settings.lookaheadFrames = static_cast<int>(readDoubleFromJSON(chunksValue, "lookahead_frames", settings.lookaheadFrames));
+    if (settings.chunkSize <= 0 || settings.loadRadius < 0) {
+        std::cout << "error: world_chunks in " << scene.getScenePath() << " needs a positive chunk_size and load_radius";
+        exit(0);
+    }
+    scene.setWorldStreamer(std::make_unique<WorldStreamer>(scene.getScenePath(), settings, renderer));
+}
+
+void Input::resolveTemplate(const rapidjson::Value& v, Scene& scene, Engine& engine, Renderer& renderer){
+    if (v.HasMember("template") && v["template"].IsString()) {
+        std::string templateName = v["template"].GetString();
+        // Check if the template is already loaded
+        if (engine.isInTemplates(templateName)) {
+            LoadProfiler::recordAsset(AssetKind::Template, templateName, 0, 0.0, true);
+        }
+        else {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            std::optional<ResourceEntry> templateEntry = ResourceManifest::find(ResourceType::Template, templateName);
+            // if the template file is missing, print error message and exit
+            if (!templateEntry.has_value()) {
+                std::cout << "error: template " << templateName << " is missing";
                 exit(0);
             }
-            nearbyDialogueSFX = sound_effect;
+            // read the template file and add it to the engine
+            JsonFile templateFile(templateEntry->path);
+            Template newTemplate(templateFile.getDocument(), renderer, templateName);
+            engine.addTemplate(templateName, newTemplate);
+            // its json and its images are in the report on their own too
+            LoadProfiler::recordAsset(AssetKind::Template, templateName, templateEntry->size, LoadProfiler::millisecondsSince(start), false);
+        }
+        scene.addTemplateName(templateName);
+    }
+}
+
+Actor Input::buildActor(const rapidjson::Value& v, Engine& engine, Renderer& renderer, const std::string& textureOwner, ActorRecord& record, std::optional<int> actorID){
+    // initialize all properties to default values
+    std::string name = "";
+    double x = 0;
+    double y = 0;
+    float vel_x = 0;
+    float vel_y = 0;
+    std::string nearby_dialogue = "";
+    std::string contact_dialogue = "";
+    SDL_Texture* view_image = nullptr;
+    SDL_Texture* view_image_back = nullptr;
+    SDL_Texture* view_image_damage = nullptr;
+    SDL_Texture* view_image_attack = nullptr;
+    double transform_scale_x = 1.0;
+    double transform_scale_y = 1.0;
+    double transform_rotation_degrees = 0.0;
+    std::optional<double> view_pivot_offset_x; // default is actor_view.w * 0.5
+    std::optional<double> view_pivot_offset_y;
+    std::optional<int> render_order;
+    bool bounce = false;
+    std::optional<float> collider_width;
+    std::optional<float> collider_height;
+    std::optional<float> trigger_width;
+    std::optional<float> trigger_height;
+    const AnimationSet* animations = nullptr;
+    std::vector<EmitterConfig> particle_emitters;
+    
+
+
+    // see if actor has a template, resolveTemplate has already loaded it
+    if (v.HasMember("template") && v["template"].IsString()) {
+		    std::string templateName = v["template"].GetString();
+        // get the template from the engine
+        Template& curr_template = engine.getTemplate(templateName);
+        // Apply properties from template
+        name = curr_template.name;
+        x = curr_template.x;
+        y = curr_template.y;
+        vel_x = curr_template.vel_x;
+        vel_y = curr_template.vel_y;
+        nearby_dialogue = curr_template.nearby_dialogue;
+        contact_dialogue = curr_template.contact_dialogue;
+        view_image = curr_template.view_image;
+        view_image_back = curr_template.view_image_back;
+        view_image_damage = curr_template.view_image_damage;
+        view_image_attack = curr_template.view_image_attack;
+        transform_scale_x = curr_template.transform_scale_x;
+        transform_scale_y = curr_template.transform_scale_y;
+        transform_rotation_degrees = curr_template.transform_rotation_degrees;
+        view_pivot_offset_x = curr_template.view_pivot_offset_x;
+        view_pivot_offset_y = curr_template.view_pivot_offset_y;
+        render_order = curr_template.render_order;
+        bounce = curr_template.bounce;
+        collider_width = curr_template.collider_width;
+        collider_height = curr_template.collider_height;
+        trigger_width = curr_template.trigger_width;
+        trigger_height = curr_template.trigger_height;
+        particle_emitters = curr_template.particle_emitters;
+        if (!curr_template.animations.empty()) {
+            // every actor of the template points at the same clips
+            animations = &curr_template.animations;
         }
         
-        // combining vel_x and vel_y into velocity
-        glm::vec2 velocity(vel_x, vel_y);
-        // combining x and y into position
-        glm::vec2 position(x, y);
-        // Set transform scale
-        glm::vec2 transform_scale(transform_scale_x, transform_scale_y);
-        
-        // work around since name doesn't work after
-        if (name == "player"){
-            isPlayer = true;
+		} 
+
+    // override with actor-specific properties
+    if (v.HasMember("name") && v["name"].IsString()) name = v["name"].GetString();
+    //if (v.HasMember("view") && v["view"].IsString()) view = v["view"].GetString()[0];
+    if (v.HasMember("transform_position_x") && v["transform_position_x"].IsNumber()) x = v["transform_position_x"].GetDouble();
+    if (v.HasMember("transform_position_y") && v["transform_position_y"].IsNumber()) y = v["transform_position_y"].GetDouble();
+    if (v.HasMember("vel_x") && v["vel_x"].IsFloat()) vel_x = v["vel_x"].GetFloat();
+    if (v.HasMember("vel_y") && v["vel_y"].IsFloat()) vel_y = v["vel_y"].GetFloat();
+    if (v.HasMember("nearby_dialogue") && v["nearby_dialogue"].IsString()) nearby_dialogue = v["nearby_dialogue"].GetString();
+    if (v.HasMember("contact_dialogue") && v["contact_dialogue"].IsString()) contact_dialogue = v["contact_dialogue"].GetString();
+    if (v.HasMember("view_image") && v["view_image"].IsString()){
+        // load in actor image
+        view_image = renderer.getImagePointer(v["view_image"].GetString(), textureOwner);
+    }
+    if (v.HasMember("view_image_back") && v["view_image_back"].IsString()){
+        // load in actor back image
+        view_image_back = renderer.getImagePointer(v["view_image_back"].GetString(), textureOwner);
+    }
+    if (v.HasMember("view_image_damage") && v["view_image_damage"].IsString()){
+        // load in actor damaged
+        view_image_damage = renderer.getImagePointer(v["view_image_damage"].GetString(), textureOwner);
+    }
+    if (v.HasMember("view_image_attack") && v["view_image_attack"].IsString()){
+        // load in actor attacked img
+        view_image_attack = renderer.getImagePointer(v["view_image_attack"].GetString(), textureOwner);
+    }
+    if (v.HasMember("transform_scale_x") && v["transform_scale_x"].IsNumber()){
+        transform_scale_x = v["transform_scale_x"].GetDouble();
+    }
+    if (v.HasMember("transform_scale_y") && v["transform_scale_y"].IsNumber()){
+        transform_scale_y = v["transform_scale_y"].GetDouble();
+    }
+    if (v.HasMember("transform_rotation_degrees") && v["transform_rotation_degrees"].IsNumber()){
+        transform_rotation_degrees = v["transform_rotation_degrees"].GetDouble();
+    }
+    if (v.HasMember("view_pivot_offset_x") && v["view_pivot_offset_x"].IsNumber()){
+        view_pivot_offset_x = v["view_pivot_offset_x"].GetDouble();
+    }
+    if (v.HasMember("view_pivot_offset_y") && v["view_pivot_offset_y"].IsNumber()){
+        view_pivot_offset_y = v["view_pivot_offset_y"].GetDouble();
+    }
+    if (v.HasMember("render_order") && v["render_order"].IsNumber()){
+        render_order = v["render_order"].GetInt();
+    }
+    if (v.HasMember("movement_bounce_enabled") && v["movement_bounce_enabled"].IsBool()){
+        bounce =  v["movement_bounce_enabled"].GetBool();
+    }
+    if (v.HasMember("box_collider_width") && v["box_collider_width"].IsNumber()) collider_width = v["box_collider_width"].GetFloat();
+    if (v.HasMember("box_collider_height") && v["box_collider_height"].IsNumber()) collider_height = v["box_collider_height"].GetFloat();
+    
+    if (v.HasMember("box_trigger_width") && v["box_trigger_width"].IsNumber()) trigger_width = v["box_trigger_width"].GetFloat();
+    if (v.HasMember("box_trigger_height") && v["box_trigger_height"].IsNumber()) trigger_height = v["box_trigger_height"].GetFloat();
+    
+    if (v.HasMember("damage_sfx") && v["damage_sfx"].IsString()) {
+        std::string sound_effect = v["damage_sfx"].GetString();
+        if (!ResourceManifest::contains(ResourceType::Audio, sound_effect)) {
+            exit(0);
+        }
+        record.damageSFX = sound_effect;
+    }
+    
+    if (v.HasMember("step_sfx") && v["step_sfx"].IsString()) {
+        std::string sound_effect = v["step_sfx"].GetString();
+        if (!ResourceManifest::contains(ResourceType::Audio, sound_effect)) {
+            exit(0);
+        }
+        record.stepSFX = sound_effect;
+    }
+    
+    std::string nearbyDialogueSFX = "";
+    if (v.HasMember("nearby_dialogue_sfx") && v["nearby_dialogue_sfx"].IsString()) {
+        std::string sound_effect = v["nearby_dialogue_sfx"].GetString();
+        if (!ResourceManifest::contains(ResourceType::Audio, sound_effect)) {
+            exit(0);
         }
+        nearbyDialogueSFX = sound_effect;
+    }
+    
+    // combining vel_x and vel_y into velocity
+    glm::vec2 velocity(vel_x, vel_y);
+    // combining x and y into position
+    glm::vec2 position(x, y);
+    // Set transform scale
+    glm::vec2 transform_scale(transform_scale_x, transform_scale_y);
+    
+    // work around since name doesn't work after
+    record.isPlayer = name == "player";
 
-        // create the Actor object
-        Actor newActor = Actor(name, view_image, view_image_back, view_image_damage, view_image_attack, position, velocity, nearby_dialogue, contact_dialogue, transform_scale, transform_rotation_degrees, render_order, bounce);
+    // create the Actor object
+    Actor newActor = Actor(name, view_image, view_image_back, view_image_damage, view_image_attack, position, velocity, nearby_dialogue, contact_dialogue, transform_scale, transform_rotation_degrees, render_order, bounce, actorID);
+    newActor.setAnimations(animations);
+    // actors can only add emitters on top of their template's
+    if (v.HasMember("particle_emitters") && v["particle_emitters"].IsArray()) {
+        readEmitters(v["particle_emitters"], renderer, textureOwner, particle_emitters);
+    }
+    record.particleEmitters = std::move(particle_emitters);
+    // Set flip
+    newActor.setFlip();
+    // set pivot position
+    newActor.setPivotPoint(view_pivot_offset_x, view_pivot_offset_y);
+    
+    // set initial direction
+    if (vel_x < 0) {
+        newActor.setDirection(West);
+    }
+    if (velocity.y < 0) {
+        newActor.setDirection(North);
+    }
+    
+    // if the actor has a non-0 velocity, it goes in the moving actors list
+    record.isMoving = vel_x != 0 || vel_y != 0;
+    
+    // set NPC dialogue sfx
+    newActor.setNearbyDialogueSFX(nearbyDialogueSFX);
+    
+    // check if it has collider width and height --> calculate box collider
+    if (collider_width.has_value() && collider_height.has_value()){
+        newActor.setupCollider(collider_width.value(), collider_height.value(), ColliderType::Collision);
+        record.hasCollider = true;
+    }
+    
+    if (trigger_width.has_value() && trigger_height.has_value()){
+        newActor.setupCollider(trigger_width.value(), trigger_height.value(), ColliderType::Trigger);
+        record.hasTrigger = true;
+    }
+    return newActor;
+}
 
-        // add the new Actor object to the vector
-        actors.push_back(std::move(newActor));
+void Input::registerActors(Scene& scene, Engine& engine, std::vector<Actor>& actors, const std::vector<ActorRecord>& records){
+    // same order the lists were filled in when actors registered as they were built
+    for (size_t i = 0; i < records.size(); ++i) {
+        Actor& actor = actors[i];
+        const ActorRecord& record = records[i];
+        for (const EmitterConfig& emitterConfig : record.particleEmitters) {
+            scene.getParticles().addEmitter(emitterConfig, &actor);
+        }
+        if (record.isMoving) {
+            scene.addMovingActor(&actor);
+        }
+        if (record.hasCollider) {
+            scene.addCollisionActor(&actor);
+        }
+        if (record.hasTrigger) {
+            scene.addTriggerActor(&actor);
+        }
+        // if the actor is the player, set the player pointer in the scene and add them to the moving actors list
+        if (record.isPlayer) {
+            scene.setPlayer(&actor);
+            scene.addMovingActor(&actor);
+        }
+        // the last actor to name one wins
+        if (!record.damageSFX.empty()) {
+            engine.setDamageSFX(record.damageSFX);
+        }
+        if (!record.stepSFX.empty()) {
+            engine.setStepSFX(record.stepSFX);
+        }
+    }
+}
 
-        Actor& newActorRef = actors.back();
-        // Set flip
-        newActorRef.setFlip();
-        // set pivot position
-        newActorRef.setPivotPoint(view_pivot_offset_x, view_pivot_offset_y);
-        
-        // set initial direction
-        if (vel_x < 0) {
-            newActorRef.setDirection(West);
+void Input::validateActor(const rapidjson::Value& v){
+    static const char* sfxProperties[] = {"damage_sfx", "step_sfx", "nearby_dialogue_sfx"};
+    for (const char* property : sfxProperties) {
+        if (v.HasMember(property) && v[property].IsString() && !ResourceManifest::contains(ResourceType::Audio, v[property].GetString())) {
+            exit(0);
+        }
+    }
+    if (v.HasMember("particle_emitters") && v["particle_emitters"].IsArray()) {
+        validateEmitters(v["particle_emitters"]);
+    }
+}
+
+void Input::validateEmitters(const rapidjson::Value& emittersValue){
+    for (auto& v : emittersValue.GetArray()) {
+        if (!v.IsObject() || !v.HasMember("image") || !v["image"].IsString()) {
+            std::cout << "error: particle emitter is missing an image";
+            exit(0);
         }
-        if (velocity.y < 0) {
-            newActorRef.setDirection(North);
+        EmitterTrigger trigger;
+        if (v.HasMember("trigger") && v["trigger"].IsString() && !emitterTriggerFromName(v["trigger"].GetString(), trigger)) {
+            std::cout << "error: unknown particle emitter trigger " << v["trigger"].GetString();
+            exit(0);
         }
-        
+    }
+}
 
-        // if the actor has a non-0 velocity, add them to the moving actors list
-        if (vel_x != 0 || vel_y != 0) {
-	        scene.addMovingActor(&newActorRef);
-		}
-        
-        // set NPC dialogue sfx
-        newActorRef.setNearbyDialogueSFX(nearbyDialogueSFX);
-        
-        // check if it has collider width and height --> calculate box collider
+bool Input::emitterTriggerFromName(const std::string& name, EmitterTrigger& trigger){
+    if (name == "continuous") trigger = EmitterTrigger::Continuous;
+    else if (name == "moving") trigger = EmitterTrigger::Moving;
+    else if (name == "damage") trigger = EmitterTrigger::Damage;
+    else if (name == "attack") trigger = EmitterTrigger::Attack;
+    else return false;
+    return true;
+}
 
-        if (collider_width.has_value() && collider_height.has_value()){
-            newActorRef.setupCollider(collider_width.value(), collider_height.value(), ColliderType::Collision);
-            scene.addCollisionActor(&newActorRef);
+void Input::readEmitters(const rapidjson::Value& emittersValue, Renderer& renderer, const std::string& owner, std::vector<EmitterConfig>& emitters){
+    validateEmitters(emittersValue);
+    for (auto& v : emittersValue.GetArray()) {
+        EmitterConfig config;
+        config.texture = renderer.getImagePointer(v["image"].GetString(), owner);
+        if (v.HasMember("render_order") && v["render_order"].IsInt()) {
+            config.render_order = v["render_order"].GetInt();
         }
-        
-        if (trigger_width.has_value() && trigger_height.has_value()){
-            newActorRef.setupCollider(trigger_width.value(), trigger_height.value(), ColliderType::Trigger);
-            scene.addTriggerActor(&newActorRef);
+        if (v.HasMember("trigger") && v["trigger"].IsString()) {
+            emitterTriggerFromName(v["trigger"].GetString(), config.trigger);
+        }
+        config.rate = readFloatFromJSON(v, "rate", config.rate);
+        config.burst = static_cast<int>(readDoubleFromJSON(v, "burst", config.burst));
+        config.lifetime = static_cast<int>(readDoubleFromJSON(v, "lifetime", config.lifetime));
+        config.speed_min = readFloatFromJSON(v, "speed_min", config.speed_min);
+        config.speed_max = readFloatFromJSON(v, "speed_max", config.speed_max);
+        config.angle_min = readFloatFromJSON(v, "angle_min", config.angle_min);
+        config.angle_max = readFloatFromJSON(v, "angle_max", config.angle_max);
+        config.gravity = readFloatFromJSON(v, "gravity", config.gravity);
+        config.size_start = readFloatFromJSON(v, "size_start", config.size_start);
+        config.size_end = readFloatFromJSON(v, "size_end", config.size_end);
+        config.color.r = static_cast<Uint8>(readDoubleFromJSON(v, "color_r", 255));
+        config.color.g = static_cast<Uint8>(readDoubleFromJSON(v, "color_g", 255));
+        config.color.b = static_cast<Uint8>(readDoubleFromJSON(v, "color_b", 255));
+        config.color.a = static_cast<Uint8>(readDoubleFromJSON(v, "color_a", 255));
+        // offset from the actor, or the world position of an emitter placed in the scene
+        config.offset = glm::vec2(readFloatFromJSON(v, "x", 0.0f), readFloatFromJSON(v, "y", 0.0f));
+        emitters.push_back(config);
+    }
+}
+
+std::vector<std::string> Input::collectSceneImages(const rapidjson::Document& document, Engine& engine){
+    std::vector<std::string> imageNames;
+    std::unordered_set<std::string> seenTemplates;
+    collectImageProperties(document, imageNames);
+    for (auto& v : document["actors"].GetArray()) {
+        collectImageProperties(v, imageNames);
+        // templates that aren't loaded yet will ask for their images too
+        if (v.HasMember("template") && v["template"].IsString()) {
+            std::string templateName = v["template"].GetString();
+            if (engine.isInTemplates(templateName) || !seenTemplates.insert(templateName).second) continue;
+            std::optional<ResourceEntry> templateEntry = ResourceManifest::find(ResourceType::Template, templateName);
+            // a missing template is reported when its actor is built
+            if (!templateEntry.has_value()) continue;
+            JsonFile templateFile(templateEntry->path);
+            collectImageProperties(templateFile.getDocument(), imageNames);
         }
+    }
+    return imageNames;
+}
+
+std::vector<std::string> Input::collectChunkImages(const rapidjson::Value& actorValues){
+    std::vector<std::string> imageNames;
+    std::unordered_set<std::string> seenTemplates;
+    for (auto& v : actorValues.GetArray()) {
+        collectImageProperties(v, imageNames);
+        // loaded templates are read again too, their images are already resident and get skipped
+        if (v.HasMember("template") && v["template"].IsString() && seenTemplates.insert(v["template"].GetString()).second) {
+            std::optional<ResourceEntry> templateEntry = ResourceManifest::find(ResourceType::Template, v["template"].GetString());
+            if (!templateEntry.has_value()) continue;
+            // runs on a worker, a broken template is left for resolveTemplate to report on the main thread
+            JsonFile templateFile(templateEntry->path, true, false);
+            if (!templateFile.isValid()) continue;
+            collectImageProperties(templateFile.getDocument(), imageNames);
+        }
+    }
+    return imageNames;
+}
 
-    	// if the actor is the player, set the player pointer in the scene and add them to the moving actors list
-        if (isPlayer){
-            scene.setPlayer(&newActorRef);
-            scene.addMovingActor(&newActorRef);
+void Input::buildChunkActors(const rapidjson::Value& actorValues, Scene& scene, Engine& engine, Renderer& renderer, const std::string& textureOwner, std::vector<Actor>& actors, std::vector<ActorRecord>& records){
+    // sized once, the scene's lists point into it until the chunk unloads
+    actors.reserve(actorValues.Size());
+    records.reserve(actorValues.Size());
+    for (auto& v : actorValues.GetArray()) {
+        resolveTemplate(v, scene, engine, renderer);
+        records.emplace_back();
+        actors.push_back(buildActor(v, engine, renderer, textureOwner, records.back()));
+        // the camera follows the player, it can't live in something the camera streams out
+        if (records.back().isPlayer) {
+            std::cout << "error: player found in world chunk " << textureOwner << ", it has to be in the scene file";
+            exit(0);
+        }
+    }
+}
+
+void Input::collectImageProperties(const rapidjson::Value& value, std::vector<std::string>& imageNames){
+    static const char* imageProperties[] = {"view_image", "view_image_back", "view_image_damage", "view_image_attack"};
+    for (const char* property : imageProperties) {
+        if (value.HasMember(property) && value[property].IsString()) {
+            imageNames.push_back(value[property].GetString());
+        }
+    }
+    if (value.HasMember("particle_emitters") && value["particle_emitters"].IsArray()) {
+        for (auto& emitter : value["particle_emitters"].GetArray()) {
+            if (emitter.IsObject() && emitter.HasMember("image") && emitter["image"].IsString()) {
+                imageNames.push_back(emitter["image"].GetString());
+            }
+        }
+    }
+    if (value.HasMember("animations") && value["animations"].IsObject()) {
+        for (auto it = value["animations"].MemberBegin(); it != value["animations"].MemberEnd(); ++it) {
+            if (it->value.IsObject() && it->value.HasMember("image") && it->value["image"].IsString()) {
+                imageNames.push_back(it->value["image"].GetString());
+            }
         }
     }
 }
@@ -12,6 +12,7 @@
 #include <cstdlib>
 #include <filesystem>
 #include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include "Actor.hpp"
 #include "rapidjson/document.h"
@@ -22,28 +23,64 @@
 class Engine;
 class Camera;
 class IntroHandler;
+struct ActorRecord;
+
 class Input{
 public:
-    static void ReadJsonFile(const std::string& path, rapidjson::Document& out_document);
     static void checkResourcesDirectory();
     static void readGameFile(Renderer& window, IntroHandler& intro, Engine& engine, const rapidjson::Document& document);
+    // read ahead of the rest of game.config so the startup report covers all of it
+    static void readLoadProfileConfig(const rapidjson::Document& document);
     static void readRenderFile(Renderer& renderer, Camera& camera);
     static std::string getInitialScene(const rapidjson::Document& document);
     static std::string getIntroSong(rapidjson::Document& document);
     static std::string getMainSong(rapidjson::Document& document);
     static std::string getHPImg(rapidjson::Document& document);
     static void readScene(Scene& scene, Engine& engine, Renderer& renderer);
+    // hot reload: diffs the scene file against the running scene and rebuilds only what changed
+    // actors of changedTemplates (or every actor with rebuildAll) are rebuilt but keep their runtime state
+    static void patchScene(Scene& scene, Engine& engine, Renderer& renderer, const std::unordered_set<std::string>& changedTemplates, bool rebuildAll);
+    static bool reloadTemplate(const std::string& templateName, Engine& engine, Renderer& renderer);
+    static void readEmitters(const rapidjson::Value& emittersValue, Renderer& renderer, const std::string& owner, std::vector<EmitterConfig>& emitters);
     static bool checkTemplates();
     static std::string obtain_word_after_phrase(const std::string& input, const std::string& phrase);
     static void findScene(std::string scenePath);
     static std::string extractSceneName(const std::string& path);
+    // world chunks: actors of one chunk file, built on the main thread once its images are decoded
+    static void buildChunkActors(const rapidjson::Value& actorValues, Scene& scene, Engine& engine, Renderer& renderer, const std::string& textureOwner, std::vector<Actor>& actors, std::vector<ActorRecord>& records);
+    // every image the actors and their templates use, safe on a worker (the engine isn't asked what's loaded)
+    static std::vector<std::string> collectChunkImages(const rapidjson::Value& actorValues);
+    static void registerActors(Scene& scene, Engine& engine, std::vector<Actor>& actors, const std::vector<ActorRecord>& records);
+    // the images an actor, template or scene names directly
+    static void collectImageProperties(const rapidjson::Value& value, std::vector<std::string>& imageNames);
 private:
+    static void readSceneStreaming(Scene& scene, Engine& engine, Renderer& renderer);
+    static void readSceneEmitters(const rapidjson::Value& document, Scene& scene, Renderer& renderer, const std::string& textureOwner);
+    static void readVoiceSettings(const rapidjson::Document& document, Engine& engine);
+    static void readWorldChunks(const rapidjson::Value& document, Scene& scene, Renderer& renderer);
+    // loads the actor's template if it has one and isn't loaded yet
+    static void resolveTemplate(const rapidjson::Value& v, Scene& scene, Engine& engine, Renderer& renderer);
+    // everything buildActor exits on, for loaders that build actors on the pool: exit() there would
+    // tear down the pool from one of its own workers
+    static void validateActor(const rapidjson::Value& v);
+    static void validateEmitters(const rapidjson::Value& emittersValue);
+    static bool emitterTriggerFromName(const std::string& name, EmitterTrigger& trigger);
+    // builds one actor from its json desc, touches nothing shared so it can run on any thread
+    // scene lists and engine sfx are left to registerActors
+    static Actor buildActor(const rapidjson::Value& v, Engine& engine, Renderer& renderer, const std::string& textureOwner, ActorRecord& record, std::optional<int> actorID = std::nullopt);
+    static void buildActorsParallel(const rapidjson::Value& actorValues, Scene& scene, Engine& engine, Renderer& renderer, const std::string& textureOwner, std::vector<ActorRecord>& records);
+    static uintmax_t sceneStreamingThreshold;
+    static bool parallelActorConstruction;
+    static bool hotReload;
+    static bool parseForReload(const std::string& path, rapidjson::Document& document);
+    static uint64_t hashValue(const rapidjson::Value& value);
     static bool readBoolFromJSON(const rapidjson::Document& document, const std::string& memberName, bool defaultValue);
     static int readIntFromJSON(const rapidjson::Document& document, const std::string& memberName, int defaultValue);
     static double readDoubleFromJSON(const rapidjson::Value& value, const std::string& memberName, double defaultValue);
     static float readFloatFromJSON(const rapidjson::Value& value, const std::string& memberName, float defaultValue);
     static std::string readStringFromJSON(const rapidjson::Document& document, const std::string& memberName, const std::string& defaultValue);
     static std::vector<std::string> readStringArrayFromJSON(const rapidjson::Document& document, const std::string& memberName);
+    static std::vector<std::string> collectSceneImages(const rapidjson::Document& document, Engine& engine);
     static std::string loadInAudio(const rapidjson::Document& document, const std::string audio_property);
 };
 
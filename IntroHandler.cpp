@@ -18,11 +18,13 @@ void IntroHandler::ProcessEvent(const SDL_Event& e) {
     // Check for left click event
     if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
         currIntroIndex++;
+        renderer->MarkDirty();
     }
     // Check for spacebar or enter event
     else if (e.type == SDL_KEYDOWN) {
         if (e.key.keysym.scancode == SDL_SCANCODE_SPACE || e.key.keysym.scancode == SDL_SCANCODE_RETURN) {
             currIntroIndex++;
+            renderer->MarkDirty();
         }
     }
 }
@@ -0,0 +1,180 @@
+//
+//  JsonFile.cpp
+//  game_engine
+//
+
+#include "JsonFile.hpp"
+#include "ResourceManifest.hpp"
+#include "LoadProfiler.hpp"
+#include <iostream>
+#include <fstream>
+#include <mutex>
+#include <algorithm>
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+// first pool block handed to a new document, blocks grow to fit the largest file seen
+#define JSON_BLOCK_SIZE (256 * 1024)
+
+// blocks not in use by a live JsonFile, scenes load templates while their own file is still open
+static std::mutex blockMutex;
+static std::vector<std::vector<char>> freeBlocks;
+
+JsonFile::JsonFile(const std::string& path, bool parseDocument, bool exitOnError)
+    : allocator(block.memory.data(), block.memory.size()), document(&allocator)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (!map(path)) {
+        if (!exitOnError) {
+            // an empty text, so readers that don't check isValid() just see nothing
+            valid = false;
+            fallback.assign(1, '\0');
+            data = fallback.data();
+            size = 0;
+            return;
+        }
+        std::cout << "error parsing json at [" << path << "]" << std::endl;
+        exit(0);
+    }
+    uintmax_t bytesRead = data == fallback.data() ? fallback.size() - 1 : size;
+    if (!parseDocument) {
+        LoadProfiler::recordAsset(AssetKind::Json, path, bytesRead, LoadProfiler::millisecondsSince(start), false);
+        return;
+    }
+    if (packed) {
+        // the pack is mapped read only, strings are copied into the pool instead
+        document.Parse(data, size);
+    }
+    else {
+        document.ParseInsitu(data);
+    }
+    if (document.HasParseError()) {
+        valid = false;
+        if (!exitOnError) return;
+        std::cout << "error parsing json at [" << path << "]" << std::endl;
+        exit(0);
+    }
+    LoadProfiler::recordAsset(AssetKind::Json, path, bytesRead, LoadProfiler::millisecondsSince(start), false);
+}
+
+JsonFile::~JsonFile() {
+    block.bytesUsed = allocator.Size();
+    document.SetNull();
+    unmap();
+}
+
+rapidjson::Document& JsonFile::getDocument() {
+    return document;
+}
+
+const char* JsonFile::getText() const {
+    return data;
+}
+
+bool JsonFile::isValid() const {
+    return valid;
+}
+
+bool JsonFile::map(const std::string& path) {
+    // files in the mounted pack are already mapped and 0 terminated
+    std::optional<ResourceEntry> entry = ResourceManifest::findPath(path);
+    if (entry.has_value() && entry->data) {
+        data = const_cast<char*>(entry->data);
+        size = static_cast<size_t>(entry->size);
+        packed = true;
+        return true;
+    }
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file, &fileSize);
+    size = static_cast<size_t>(fileSize.QuadPart);
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    // the bytes after the end of the file up to the page boundary read as 0, which terminates the text
+    if (size > 0 && size % systemInfo.dwPageSize != 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        if (mapping) {
+            // copy on write, parsing in place never touches the file itself
+            data = static_cast<char*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+            if (data) {
+                fileHandle = file;
+                mappingHandle = mapping;
+                return true;
+            }
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) return false;
+    struct stat fileStat;
+    if (fstat(file, &fileStat) != 0) {
+        close(file);
+        return false;
+    }
+    size = static_cast<size_t>(fileStat.st_size);
+    long pageSize = sysconf(_SC_PAGESIZE);
+    // the bytes after the end of the file up to the page boundary read as 0, which terminates the text
+    if (size > 0 && size % pageSize != 0) {
+        // private mapping, parsing in place copies only the pages it writes to
+        void* mapped = mmap(nullptr, size + 1, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+        close(file);
+        if (mapped != MAP_FAILED) {
+            data = static_cast<char*>(mapped);
+            return true;
+        }
+    }
+    else {
+        close(file);
+    }
+#endif
+    // empty files and files that end exactly on a page are read into memory instead
+    std::ifstream stream(path, std::ios::in | std::ios::binary);
+    if (!stream.is_open()) return false;
+    fallback.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    fallback.push_back('\0');
+    data = fallback.data();
+    size = 0;
+    return true;
+}
+
+void JsonFile::unmap() {
+    if (data && !packed && data != fallback.data()) {
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+#else
+        munmap(data, size + 1);
+#endif
+    }
+    data = nullptr;
+}
+
+JsonFile::PoolBlock::PoolBlock() {
+    std::lock_guard<std::mutex> lock(blockMutex);
+    if (freeBlocks.empty()) {
+        memory.resize(JSON_BLOCK_SIZE);
+        return;
+    }
+    memory = std::move(freeBlocks.back());
+    freeBlocks.pop_back();
+}
+
+JsonFile::PoolBlock::~PoolBlock() {
+    // the document spilled past its block, next time hand out one big enough to hold it
+    if (bytesUsed > memory.size()) {
+        memory.resize(bytesUsed + bytesUsed / 4);
+    }
+    std::lock_guard<std::mutex> lock(blockMutex);
+    freeBlocks.push_back(std::move(memory));
+}
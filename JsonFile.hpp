@@ -0,0 +1,57 @@
+//
+//  JsonFile.hpp
+//  game_engine
+//
+
+#ifndef JsonFile_hpp
+#define JsonFile_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "rapidjson/document.h"
+
+// a json file memory mapped and parsed in place, strings in the document point into the mapping
+// files in the mounted resource pack are read straight from the pack's mapping, which is read only,
+// so their strings are copied into the document's pool instead of pointing into the file
+// the document's nodes come from a pool block that is handed back for the next file when this one is done
+// keep the JsonFile alive for as long as anything reads the document
+class JsonFile {
+public:
+    // with parseDocument false the file is only mapped, for readers that walk getText() themselves
+    // with exitOnError false a file that can't be read or parsed is only marked invalid (and its text is empty),
+    // for reads on the thread pool, where exit() would tear the pool down from one of its own workers
+    explicit JsonFile(const std::string& path, bool parseDocument = true, bool exitOnError = true);
+    ~JsonFile();
+    JsonFile(const JsonFile&) = delete;
+    JsonFile& operator=(const JsonFile&) = delete;
+    rapidjson::Document& getDocument();
+    // the 0 terminated file contents
+    const char* getText() const;
+    bool isValid() const;
+private:
+    // the pool's first chunk, destroyed last so the allocator is done with it before it's handed on
+    struct PoolBlock {
+        PoolBlock();
+        ~PoolBlock();
+        std::vector<char> memory;
+        size_t bytesUsed = 0;
+    };
+    PoolBlock block;
+    bool map(const std::string& path);
+    void unmap();
+
+    char* data = nullptr;      // mapped (or read) file contents plus a terminating 0
+    size_t size = 0;
+    bool valid = true;
+    bool packed = false;       // data points into the resource pack, which is read only and not ours to unmap
+    std::vector<char> fallback; // used when the file can't be mapped with room for the terminator
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+    rapidjson::MemoryPoolAllocator<> allocator;
+    rapidjson::Document document;
+};
+
+#endif /* JsonFile_hpp */
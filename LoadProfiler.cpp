@@ -0,0 +1,173 @@
+//
+//  LoadProfiler.cpp
+//  game_engine
+//
+
+#include "LoadProfiler.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+std::mutex LoadProfiler::mutex;
+std::atomic<bool> LoadProfiler::active(false);
+bool LoadProfiler::enabled = false;
+std::string LoadProfiler::jsonPath = "load_profile.jsonl";
+std::string LoadProfiler::label = "";
+std::chrono::steady_clock::time_point LoadProfiler::reportBegin;
+std::vector<LoadProfiler::AssetStats> LoadProfiler::assets;
+std::unordered_map<std::string, size_t> LoadProfiler::assetIndex;
+std::vector<std::pair<std::string, double>> LoadProfiler::phases;
+
+void LoadProfiler::configure(bool enabled_in, const std::string& jsonPath_in) {
+    std::lock_guard<std::mutex> lock(mutex);
+    enabled = enabled_in;
+    jsonPath = jsonPath_in;
+}
+
+bool LoadProfiler::isActive() {
+    return active.load(std::memory_order_relaxed);
+}
+
+void LoadProfiler::begin(const std::string& label_in, std::chrono::steady_clock::time_point start) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!enabled) return;
+    label = label_in;
+    reportBegin = start;
+    assets.clear();
+    assetIndex.clear();
+    phases.clear();
+    active = true;
+}
+
+double LoadProfiler::millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void LoadProfiler::recordAsset(AssetKind kind, const std::string& name, uintmax_t bytes, double milliseconds, bool cacheHit) {
+    if (!isActive()) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string key = std::string(kindName(kind)) + ":" + name;
+    auto it = assetIndex.find(key);
+    if (it == assetIndex.end()) {
+        AssetStats stats;
+        stats.kind = kind;
+        stats.name = name;
+        assets.push_back(stats);
+        it = assetIndex.emplace(key, assets.size() - 1).first;
+    }
+    AssetStats& stats = assets[it->second];
+    if (cacheHit) {
+        stats.hits++;
+    }
+    else {
+        stats.misses++;
+        stats.bytes += bytes;
+        stats.milliseconds += milliseconds;
+    }
+}
+
+void LoadProfiler::recordPhase(const std::string& phase, double milliseconds) {
+    if (!isActive()) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::pair<std::string, double>& existing : phases) {
+        if (existing.first == phase) {
+            existing.second += milliseconds;
+            return;
+        }
+    }
+    phases.emplace_back(phase, milliseconds);
+}
+
+void LoadProfiler::end() {
+    if (!isActive()) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    active = false;
+    double totalMilliseconds = millisecondsSince(reportBegin);
+
+    // one line for the console, per kind: files, bytes, decode time, hits and misses
+    uintmax_t kindBytes[ASSET_KIND_COUNT] = {};
+    double kindMilliseconds[ASSET_KIND_COUNT] = {};
+    int kindHits[ASSET_KIND_COUNT] = {};
+    int kindMisses[ASSET_KIND_COUNT] = {};
+    for (const AssetStats& stats : assets) {
+        int kind = static_cast<int>(stats.kind);
+        kindBytes[kind] += stats.bytes;
+        kindMilliseconds[kind] += stats.milliseconds;
+        kindHits[kind] += stats.hits;
+        kindMisses[kind] += stats.misses;
+    }
+    std::ostringstream summary;
+    summary << std::fixed << std::setprecision(1) << "load profile: " << label << " " << totalMilliseconds << " ms";
+    for (int kind = 0; kind < ASSET_KIND_COUNT; ++kind) {
+        if (kindHits[kind] + kindMisses[kind] == 0) continue;
+        summary << " | " << kindName(static_cast<AssetKind>(kind)) << " " << kindMisses[kind] << " miss " << kindHits[kind] << " hit "
+                << kindBytes[kind] / 1024 << " KB " << kindMilliseconds[kind] << " ms";
+    }
+    for (const std::pair<std::string, double>& phase : phases) {
+        summary << " | " << phase.first << " " << phase.second << " ms";
+    }
+    std::cout << summary.str() << std::endl;
+    writeJson(totalMilliseconds);
+}
+
+void LoadProfiler::writeJson(double totalMilliseconds) {
+    if (jsonPath == "") return;
+    // appended a report per line, so loads can be compared across runs
+    std::ofstream log(jsonPath, std::ios::out | std::ios::app);
+    if (!log.is_open()) {
+        std::cerr << "error: can't write load profile to " << jsonPath << std::endl;
+        return;
+    }
+    long long timestamp = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    log << std::fixed << std::setprecision(3);
+    log << "{\"label\":\"" << escape(label) << "\",\"timestamp\":" << timestamp << ",\"total_ms\":" << totalMilliseconds;
+    log << ",\"phases\":{";
+    for (size_t i = 0; i < phases.size(); ++i) {
+        log << (i > 0 ? "," : "") << "\"" << escape(phases[i].first) << "\":" << phases[i].second;
+    }
+    log << "},\"assets\":[";
+    for (size_t i = 0; i < assets.size(); ++i) {
+        const AssetStats& stats = assets[i];
+        log << (i > 0 ? "," : "") << "{\"kind\":\"" << kindName(stats.kind) << "\",\"name\":\"" << escape(stats.name)
+            << "\",\"bytes\":" << stats.bytes << ",\"ms\":" << stats.milliseconds << ",\"hits\":" << stats.hits << ",\"misses\":" << stats.misses << "}";
+    }
+    log << "]}\n";
+}
+
+const char* LoadProfiler::kindName(AssetKind kind) {
+    switch (kind) {
+        case AssetKind::Json: return "json";
+        case AssetKind::Template: return "template";
+        case AssetKind::Image: return "image";
+        case AssetKind::Audio: return "audio";
+        case AssetKind::Font: return "font";
+    }
+    return "";
+}
+
+std::string LoadProfiler::escape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20) {
+            std::ostringstream code;
+            code << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
+            escaped += code.str();
+        }
+        else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+LoadProfiler::PhaseTimer::PhaseTimer(const char* phase_in) : phase(phase_in), start(std::chrono::steady_clock::now()) {
+}
+
+LoadProfiler::PhaseTimer::~PhaseTimer() {
+    recordPhase(phase, millisecondsSince(start));
+}
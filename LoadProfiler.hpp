@@ -0,0 +1,76 @@
+//
+//  LoadProfiler.hpp
+//  game_engine
+//
+
+#ifndef LoadProfiler_hpp
+#define LoadProfiler_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+
+enum class AssetKind {
+    Json,
+    Template,
+    Image,
+    Audio,
+    Font
+};
+
+#define ASSET_KIND_COUNT 5
+
+// a report per scene load of what every asset cost and where the time went
+// the loaders record into it unconditionally, anything outside begin() and end() is dropped
+// assets can be recorded from the workers, phases are timed on the main thread
+class LoadProfiler {
+public:
+    static void configure(bool enabled, const std::string& jsonPath);
+    static bool isActive();
+    static void begin(const std::string& label, std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now());
+    // prints the summary line and appends the report as one line of json to the log
+    static void end();
+    // bytes read and decode time for a miss, a hit only counts
+    static void recordAsset(AssetKind kind, const std::string& name, uintmax_t bytes, double milliseconds, bool cacheHit);
+    static void recordPhase(const std::string& phase, double milliseconds);
+    static double millisecondsSince(std::chrono::steady_clock::time_point start);
+
+    // adds the time from construction to destruction to a phase
+    class PhaseTimer {
+    public:
+        explicit PhaseTimer(const char* phase);
+        ~PhaseTimer();
+    private:
+        const char* phase;
+        std::chrono::steady_clock::time_point start;
+    };
+private:
+    struct AssetStats {
+        AssetKind kind = AssetKind::Json;
+        std::string name;
+        uintmax_t bytes = 0;
+        double milliseconds = 0.0;
+        int hits = 0;
+        int misses = 0;
+    };
+    static const char* kindName(AssetKind kind);
+    static std::string escape(const std::string& text);
+    static void writeJson(double totalMilliseconds);
+
+    static std::mutex mutex;
+    static std::atomic<bool> active;
+    static bool enabled;
+    static std::string jsonPath;
+    static std::string label;
+    static std::chrono::steady_clock::time_point reportBegin;
+    static std::vector<AssetStats> assets;
+    static std::unordered_map<std::string, size_t> assetIndex;
+    static std::vector<std::pair<std::string, double>> phases; // in the order they first ran
+};
+
+#endif /* LoadProfiler_hpp */
@@ -0,0 +1,142 @@
+//
+//  MusicPlayer.cpp
+//  game_engine
+//
+
+#include "MusicPlayer.hpp"
+#include "ResourceManifest.hpp"
+#include "LoadProfiler.hpp"
+#include "External/AudioHelper.h"
+#include <iostream>
+#include <algorithm>
+
+MusicPlayer::~MusicPlayer() {
+    Mix_HaltMusic();
+    if (stream) Mix_FreeMusic(stream);
+    if (pendingStream) Mix_FreeMusic(pendingStream);
+}
+
+void MusicPlayer::configure(uintmax_t streamingThreshold_in, int crossfadeMilliseconds_in) {
+    streamingThreshold = streamingThreshold_in;
+    crossfadeMilliseconds = std::max(crossfadeMilliseconds_in, 0);
+}
+
+bool MusicPlayer::shouldStream(const std::string& trackName) const {
+    std::optional<ResourceEntry> entry = ResourceManifest::find(ResourceType::Audio, trackName);
+    return entry.has_value() && entry->size >= streamingThreshold;
+}
+
+Mix_Music* MusicPlayer::openStream(const std::string& trackName) {
+    std::optional<ResourceEntry> entry = ResourceManifest::find(ResourceType::Audio, trackName);
+    if (!entry.has_value()) {
+        return nullptr;
+    }
+    // only the header is read here, the rest is decoded as it plays, from the file or the pack mapping
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Mix_Music* music = Mix_LoadMUS_RW(ResourceManifest::open(*entry), 1);
+    if (music) {
+        LoadProfiler::recordAsset(AssetKind::Audio, trackName, 0, LoadProfiler::millisecondsSince(start), false);
+    }
+    return music;
+}
+
+void MusicPlayer::play(const std::string& trackName, Mix_Chunk* chunk, int numPlays) {
+    // asking for the looping track that's already on keeps it going
+    bool playing = chunkChannel >= 0 ? Mix_Playing(chunkChannel) != 0 : (stream && !pendingStream && Mix_PlayingMusic());
+    if (trackName == currentTrack && currentLoops && numPlays == -1 && playing) return;
+
+    fadeOutCurrent();
+    currentTrack = trackName;
+    currentLoops = numPlays == -1;
+    if (chunk) {
+        if (crossfadeMilliseconds > 0) {
+            // on the channel the last track isn't fading out on
+            chunkChannel = lastChunkChannel == MUSIC_CHANNEL ? MUSIC_FADE_CHANNEL : MUSIC_CHANNEL;
+            Mix_FadeInChannel(chunkChannel, chunk, numPlays, crossfadeMilliseconds);
+        }
+        else {
+            chunkChannel = MUSIC_CHANNEL;
+            AudioHelper::Mix_PlayChannel498(chunkChannel, chunk, numPlays);
+        }
+        lastChunkChannel = chunkChannel;
+        return;
+    }
+
+    Mix_Music* music = openStream(trackName);
+    if (!music) {
+        std::cout << "error: failed to play audio clip " << trackName;
+        exit(0);
+    }
+    if (stream && Mix_PlayingMusic()) {
+        // still fading out, update() starts this one once it's gone
+        if (pendingStream) Mix_FreeMusic(pendingStream);
+        pendingStream = music;
+        pendingNumPlays = numPlays;
+        return;
+    }
+    startStream(music, numPlays);
+}
+
+void MusicPlayer::startStream(Mix_Music* music, int numPlays) {
+    if (stream) {
+        Mix_HaltMusic();
+        Mix_FreeMusic(stream);
+    }
+    stream = music;
+    if (crossfadeMilliseconds > 0) {
+        Mix_FadeInMusic(stream, numPlays, crossfadeMilliseconds);
+    }
+    else {
+        Mix_PlayMusic(stream, numPlays);
+    }
+}
+
+void MusicPlayer::fadeOutCurrent() {
+    // a track stopped already is fading out or gone
+    if (currentTrack == "") return;
+    if (chunkChannel >= 0) {
+        if (crossfadeMilliseconds > 0) {
+            Mix_FadeOutChannel(chunkChannel, crossfadeMilliseconds);
+        }
+        else {
+            AudioHelper::Mix_HaltChannel498(chunkChannel);
+        }
+    }
+    else if (pendingStream) {
+        // never got to play
+        Mix_FreeMusic(pendingStream);
+        pendingStream = nullptr;
+    }
+    else if (stream) {
+        if (crossfadeMilliseconds > 0 && Mix_PlayingMusic()) {
+            // freed once it's faded out
+            Mix_FadeOutMusic(crossfadeMilliseconds);
+        }
+        else {
+            Mix_HaltMusic();
+            Mix_FreeMusic(stream);
+            stream = nullptr;
+        }
+    }
+    currentTrack = "";
+    currentLoops = false;
+    chunkChannel = -1;
+}
+
+void MusicPlayer::stop() {
+    fadeOutCurrent();
+}
+
+void MusicPlayer::update() {
+    if (!stream || Mix_PlayingMusic()) return;
+    if (pendingStream) {
+        Mix_Music* music = pendingStream;
+        pendingStream = nullptr;
+        startStream(music, pendingNumPlays);
+    }
+    else {
+        // done playing (or faded out), nothing of it needs to stay in memory
+        Mix_FreeMusic(stream);
+        stream = nullptr;
+    }
+}
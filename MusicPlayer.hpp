@@ -0,0 +1,55 @@
+//
+//  MusicPlayer.hpp
+//  game_engine
+//
+
+#ifndef MusicPlayer_hpp
+#define MusicPlayer_hpp
+
+#include <stdio.h>
+#include <string>
+#include <cstdint>
+#ifdef __APPLE__
+    #include "SDL2/SDL.h"
+    #include "SDL2_mixer/SDL_mixer.h"
+#else
+    #include "SDL.h"
+    #include "SDL_mixer.h"
+#endif
+
+// the two channels short tracks alternate between, so one can fade in while the other fades out
+#define MUSIC_CHANNEL 0
+#define MUSIC_FADE_CHANNEL 2
+
+// background music, one track at a time
+// short tracks are played from their decoded chunk like any sound, anything at or over the threshold
+// is streamed with Mix_Music so only a small buffer of it is ever decoded and nothing is kept once it's done
+// SDL_mixer streams one track at a time, so going from a streamed track to another waits for the fade out
+class MusicPlayer {
+public:
+    ~MusicPlayer();
+    // threshold 0 streams every track, crossfade 0 cuts straight from one track to the next
+    void configure(uintmax_t streamingThreshold, int crossfadeMilliseconds);
+    bool shouldStream(const std::string& trackName) const;
+    // chunk is the decoded track, nullptr to stream it
+    void play(const std::string& trackName, Mix_Chunk* chunk, int numPlays);
+    void stop();
+    // once a frame: starts a streamed track that was waiting on the previous one to fade out
+    void update();
+private:
+    void fadeOutCurrent();
+    void startStream(Mix_Music* music, int numPlays);
+    static Mix_Music* openStream(const std::string& trackName);
+
+    uintmax_t streamingThreshold = 1024 * 1024;
+    int crossfadeMilliseconds = 0;
+    std::string currentTrack = "";
+    bool currentLoops = false;
+    int chunkChannel = -1;              // the channel of the current track, -1 if it's streamed or there is none
+    int lastChunkChannel = MUSIC_FADE_CHANNEL;
+    Mix_Music* stream = nullptr;        // the streamed track that's playing or fading out
+    Mix_Music* pendingStream = nullptr; // waits for stream to finish fading out
+    int pendingNumPlays = 0;
+};
+
+#endif /* MusicPlayer_hpp */
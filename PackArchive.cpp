@@ -0,0 +1,116 @@
+//
+//  PackArchive.cpp
+//  game_engine
+//
+
+#include "PackArchive.hpp"
+#include <iostream>
+#include <cstring>
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+PackArchive::~PackArchive() {
+    unmount();
+}
+
+bool PackArchive::mount(const std::string& path) {
+    unmount();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file, &fileSize);
+    size = static_cast<size_t>(fileSize.QuadPart);
+    HANDLE mapping = size > 0 ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!data) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+#else
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) return false;
+    struct stat fileStat;
+    if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0) {
+        close(file);
+        return false;
+    }
+    size = static_cast<size_t>(fileStat.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+    close(file);
+    if (mapped == MAP_FAILED) return false;
+    data = static_cast<const char*>(mapped);
+#endif
+    if (!readIndex()) {
+        std::cerr << "error: " << path << " is not a valid resource pack" << std::endl;
+        unmount();
+        return false;
+    }
+    return true;
+}
+
+bool PackArchive::readIndex() {
+    PackHeader header;
+    if (size < sizeof(header)) return false;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != PACK_MAGIC || header.version != PACK_VERSION) return false;
+    if (header.indexOffset > size || header.indexSize > size - header.indexOffset) return false;
+
+    // bounds are checked on every record so a truncated pack fails to mount instead of crashing later
+    const char* cursor = data + header.indexOffset;
+    const char* indexEnd = cursor + header.indexSize;
+    entries.reserve(header.entryCount);
+    for (uint32_t i = 0; i < header.entryCount; ++i) {
+        PackIndexRecord record;
+        if (static_cast<size_t>(indexEnd - cursor) < sizeof(record)) return false;
+        std::memcpy(&record, cursor, sizeof(record));
+        cursor += sizeof(record);
+        if (static_cast<size_t>(indexEnd - cursor) < record.pathLength) return false;
+        // the entry and its terminating 0 have to be inside the file, and the 0 has to be there
+        // JsonFile parses packed files in place and relies on it
+        if (record.offset > size || record.size >= size - record.offset) return false;
+        if (data[record.offset + record.size] != '\0') return false;
+        Entry entry;
+        entry.path.assign(cursor, record.pathLength);
+        entry.data = data + record.offset;
+        entry.size = static_cast<size_t>(record.size);
+        entries.push_back(std::move(entry));
+        cursor += record.pathLength;
+    }
+    return true;
+}
+
+void PackArchive::unmount() {
+    entries.clear();
+    if (!data) return;
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(static_cast<HANDLE>(mappingHandle));
+    CloseHandle(static_cast<HANDLE>(fileHandle));
+#else
+    munmap(const_cast<char*>(data), size);
+#endif
+    data = nullptr;
+    size = 0;
+}
+
+bool PackArchive::isMounted() const {
+    return data != nullptr;
+}
+
+const std::vector<PackArchive::Entry>& PackArchive::getEntries() const {
+    return entries;
+}
@@ -0,0 +1,41 @@
+//
+//  PackArchive.hpp
+//  game_engine
+//
+
+#ifndef PackArchive_hpp
+#define PackArchive_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "PackFormat.hpp"
+
+// a resources.pak mapped read only for the life of the game
+// entries are handed out as pointers into the mapping, nothing is opened or copied per file
+class PackArchive {
+public:
+    struct Entry {
+        std::string path;
+        const char* data = nullptr;
+        size_t size = 0;
+    };
+    ~PackArchive();
+    // false if the file is missing or isn't a pack this build understands
+    bool mount(const std::string& path);
+    void unmount();
+    bool isMounted() const;
+    const std::vector<Entry>& getEntries() const;
+private:
+    bool readIndex();
+
+    const char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+    std::vector<Entry> entries;
+};
+
+#endif /* PackArchive_hpp */
@@ -0,0 +1,40 @@
+//
+//  PackFormat.hpp
+//  game_engine
+//
+
+#ifndef PackFormat_hpp
+#define PackFormat_hpp
+
+#include <stdint.h>
+
+// layout of resources.pak, shared by the engine and tools/packer.cpp
+//
+// [PackHeader][entry data ...][index]
+// every entry starts on a PACK_ALIGNMENT boundary and is followed by at least one 0 byte,
+// so text entries can be parsed straight out of the mapping
+// the index is entryCount PackIndexRecords, each followed by pathLength bytes of path
+// paths are '/' separated and start with "resources/", the same paths the loaders build
+// all integers are little endian
+
+#define PACK_MAGIC 0x4B504547 // "GEPK"
+#define PACK_VERSION 1
+#define PACK_ALIGNMENT 64
+
+struct PackHeader {
+    uint32_t magic = PACK_MAGIC;
+    uint32_t version = PACK_VERSION;
+    uint32_t entryCount = 0;
+    uint32_t reserved = 0;
+    uint64_t indexOffset = 0;
+    uint64_t indexSize = 0;
+};
+
+struct PackIndexRecord {
+    uint64_t offset = 0;
+    uint64_t size = 0;
+    uint32_t pathLength = 0;
+    uint32_t reserved = 0;
+};
+
+#endif /* PackFormat_hpp */
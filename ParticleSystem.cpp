@@ -0,0 +1,202 @@
+//
+//  ParticleSystem.cpp
+//  game_engine
+//
+
+#include "ParticleSystem.hpp"
+#include <algorithm>
+#include <cmath>
+#define SCENE_UNIT 100
+
+int ParticlePool::count() const {
+    return static_cast<int>(x.size());
+}
+
+void ParticlePool::add(float px, float py, float pvx, float pvy, const EmitterConfig& config) {
+    x.push_back(px);
+    y.push_back(py);
+    vx.push_back(pvx);
+    vy.push_back(pvy);
+    ay.push_back(config.gravity);
+    age.push_back(0.0f);
+    invLife.push_back(1.0f / std::max(1, config.lifetime));
+    size.push_back(config.size_start);
+    sizeDelta.push_back((config.size_end - config.size_start) / std::max(1, config.lifetime));
+    color.push_back(config.color);
+}
+
+void ParticlePool::update() {
+    const int n = count();
+    // plain loops over separate arrays with no aliasing, the compiler turns these into SIMD
+    float* __restrict px = x.data();
+    float* __restrict py = y.data();
+    float* __restrict pvy = vy.data();
+    const float* __restrict pvx = vx.data();
+    const float* __restrict pay = ay.data();
+    float* __restrict pAge = age.data();
+    float* __restrict pSize = size.data();
+    const float* __restrict pSizeDelta = sizeDelta.data();
+    const float* __restrict pInvLife = invLife.data();
+
+    for (int i = 0; i < n; ++i) {
+        pvy[i] += pay[i];
+    }
+    for (int i = 0; i < n; ++i) {
+        px[i] += pvx[i];
+        py[i] += pvy[i];
+    }
+    for (int i = 0; i < n; ++i) {
+        pSize[i] += pSizeDelta[i];
+        // age is kept as a 0-1 fraction of the lifetime
+        pAge[i] += pInvLife[i];
+    }
+    removeDead();
+}
+
+void ParticlePool::removeDead() {
+    // swap the last particle into each dead slot, order within a pool doesn't matter
+    int n = count();
+    for (int i = 0; i < n;) {
+        if (age[i] < 1.0f) {
+            ++i;
+            continue;
+        }
+        --n;
+        x[i] = x[n]; y[i] = y[n]; vx[i] = vx[n]; vy[i] = vy[n]; ay[i] = ay[n];
+        age[i] = age[n]; invLife[i] = invLife[n]; size[i] = size[n]; sizeDelta[i] = sizeDelta[n];
+        color[i] = color[n];
+    }
+    x.resize(n); y.resize(n); vx.resize(n); vy.resize(n); ay.resize(n);
+    age.resize(n); invLife.resize(n); size.resize(n); sizeDelta.resize(n);
+    color.resize(n);
+}
+
+void ParticlePool::buildQuads(SDL_Vertex* vertices, glm::vec2 cameraPosition, float screenOffsetX, float screenOffsetY) const {
+    const int n = count();
+    for (int i = 0; i < n; ++i) {
+        float halfSize = std::max(0.0f, size[i]) * 0.5f;
+        float centerX = (x[i] - cameraPosition.x) * SCENE_UNIT + screenOffsetX;
+        float centerY = (y[i] - cameraPosition.y) * SCENE_UNIT + screenOffsetY;
+        SDL_Color fade = color[i];
+        fade.a = static_cast<Uint8>(color[i].a * std::max(0.0f, 1.0f - age[i]));
+
+        SDL_Vertex* quad = vertices + i * 4;
+        quad[0] = {{centerX - halfSize, centerY - halfSize}, fade, {0.0f, 0.0f}};
+        quad[1] = {{centerX + halfSize, centerY - halfSize}, fade, {1.0f, 0.0f}};
+        quad[2] = {{centerX - halfSize, centerY + halfSize}, fade, {0.0f, 1.0f}};
+        quad[3] = {{centerX + halfSize, centerY + halfSize}, fade, {1.0f, 1.0f}};
+    }
+}
+
+void ParticleSystem::addEmitter(const EmitterConfig& config, const Actor* actor) {
+    Emitter emitter;
+    emitter.config = config;
+    emitter.actor = actor;
+    if (actor) {
+        emitter.lastDamageFrame = actor->getLastDamagedFrame();
+        emitter.lastAttackFrame = actor->getLastAttackedFrame();
+    }
+    emitters.push_back(emitter);
+}
+
+void ParticleSystem::update() {
+    for (Emitter& emitter : emitters) {
+        const EmitterConfig& config = emitter.config;
+        switch (config.trigger) {
+            case EmitterTrigger::Moving:
+                if (!emitter.actor || !emitter.actor->isMoving()) break;
+                // fall through
+            case EmitterTrigger::Continuous: {
+                emitter.carry += config.rate;
+                int numParticles = static_cast<int>(emitter.carry);
+                emitter.carry -= numParticles;
+                emit(emitter, numParticles);
+                break;
+            }
+            case EmitterTrigger::Damage:
+                // damage can land after the particles update, so compare against the last one seen
+                if (emitter.actor && emitter.actor->getLastDamagedFrame() != emitter.lastDamageFrame) {
+                    emitter.lastDamageFrame = emitter.actor->getLastDamagedFrame();
+                    emit(emitter, config.burst);
+                }
+                break;
+            case EmitterTrigger::Attack:
+                if (emitter.actor && emitter.actor->getLastAttackedFrame() != emitter.lastAttackFrame) {
+                    emitter.lastAttackFrame = emitter.actor->getLastAttackedFrame();
+                    emit(emitter, config.burst);
+                }
+                break;
+        }
+    }
+
+    liveCount = 0;
+    for (ParticlePool& pool : pools) {
+        pool.update();
+        liveCount += pool.count();
+    }
+}
+
+void ParticleSystem::emit(Emitter& emitter, int numParticles) {
+    const EmitterConfig& config = emitter.config;
+    if (!config.texture) return;
+    numParticles = std::min(numParticles, maxParticles - liveCount);
+    if (numParticles <= 0) return;
+
+    glm::vec2 origin = config.offset;
+    if (emitter.actor) {
+        origin += emitter.actor->getPosition();
+    }
+    int layer = config.render_order.value_or(static_cast<int>(origin.y));
+    ParticlePool& pool = getPool(config.texture, layer);
+    for (int i = 0; i < numParticles; ++i) {
+        float angle = glm::radians(config.angle_min + (config.angle_max - config.angle_min) * random01());
+        float speed = config.speed_min + (config.speed_max - config.speed_min) * random01();
+        pool.add(origin.x, origin.y, std::cos(angle) * speed, std::sin(angle) * speed, config);
+    }
+    liveCount += numParticles;
+}
+
+ParticlePool& ParticleSystem::getPool(SDL_Texture* texture, int layer) {
+    auto it = std::lower_bound(pools.begin(), pools.end(), layer, [](const ParticlePool& pool, int value) {
+        return pool.layer < value;
+    });
+    for (auto search = it; search != pools.end() && search->layer == layer; ++search) {
+        if (search->texture == texture) return *search;
+    }
+    ParticlePool pool;
+    pool.texture = texture;
+    pool.layer = layer;
+    return *pools.insert(it, std::move(pool));
+}
+
+void ParticleSystem::removeEmitters(const std::unordered_set<const Actor*>& actors) {
+    emitters.erase(std::remove_if(emitters.begin(), emitters.end(), [&actors](const Emitter& emitter) {
+        return emitter.actor && actors.count(emitter.actor) > 0;
+    }), emitters.end());
+}
+
+void ParticleSystem::clear() {
+    emitters.clear();
+    pools.clear();
+    liveCount = 0;
+}
+
+const std::vector<ParticlePool>& ParticleSystem::getPools() const {
+    return pools;
+}
+
+int ParticleSystem::getLiveCount() const {
+    return liveCount;
+}
+
+void ParticleSystem::setMaxParticles(int maxCount) {
+    maxParticles = maxCount;
+}
+
+float ParticleSystem::random01() {
+    // xorshift32
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return (randomState >> 8) * (1.0f / 16777216.0f);
+}
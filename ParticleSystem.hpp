@@ -0,0 +1,90 @@
+//
+//  ParticleSystem.hpp
+//  game_engine
+//
+
+#ifndef ParticleSystem_hpp
+#define ParticleSystem_hpp
+
+#include <stdio.h>
+#include <vector>
+#include <optional>
+#include <unordered_set>
+#include "glm/glm.hpp"
+#include "Actor.hpp"
+#include "RenderCommandList.hpp"
+
+enum class EmitterTrigger {
+    Continuous,
+    Moving,     // only while the actor is moving (dust)
+    Damage,     // one burst each time the actor is damaged (hit sparks)
+    Attack      // one burst each time the actor attacks
+};
+
+// read from a template's or scene's "particle_emitters" list
+struct EmitterConfig {
+    SDL_Texture* texture = nullptr;
+    std::optional<int> render_order; // else the y of the emitter when the particle spawns
+    EmitterTrigger trigger = EmitterTrigger::Continuous;
+    float rate = 1.0f;          // particles per frame for continuous and moving emitters
+    int burst = 10;             // particles per damage/attack burst
+    int lifetime = 30;          // frames
+    float speed_min = 0.01f;    // scene units per frame
+    float speed_max = 0.05f;
+    float angle_min = 0.0f;     // degrees, 0 = east, 90 = south
+    float angle_max = 360.0f;
+    float gravity = 0.0f;       // scene units per frame per frame
+    float size_start = 8.0f;    // pixels
+    float size_end = 0.0f;
+    SDL_Color color = {255, 255, 255, 255}; // alpha fades to 0 over the lifetime
+    glm::vec2 offset = glm::vec2(0, 0);     // from the actor, or the world position of a scene emitter
+};
+
+// every live particle sharing one texture and one layer, one array per field so the update loops vectorize
+struct ParticlePool {
+    SDL_Texture* texture = nullptr;
+    int layer = 0;
+    std::vector<float> x, y, vx, vy, ay;
+    std::vector<float> age, invLife, size, sizeDelta;
+    std::vector<SDL_Color> color;
+
+    int count() const;
+    void add(float px, float py, float pvx, float pvy, const EmitterConfig& config);
+    void update();
+    // writes count() quads in screen space into vertices
+    void buildQuads(SDL_Vertex* vertices, glm::vec2 cameraPosition, float screenOffsetX, float screenOffsetY) const;
+private:
+    void removeDead();
+};
+
+class ParticleSystem {
+public:
+    void addEmitter(const EmitterConfig& config, const Actor* actor);
+    // for actors leaving the scene, their live particles finish on their own
+    void removeEmitters(const std::unordered_set<const Actor*>& actors);
+    void update();
+    void clear();
+    // pools in layer order so they can be interleaved with the sorted actors
+    const std::vector<ParticlePool>& getPools() const;
+    int getLiveCount() const;
+    void setMaxParticles(int maxCount);
+private:
+    struct Emitter {
+        EmitterConfig config;
+        const Actor* actor = nullptr; // nullptr for emitters placed in the scene
+        float carry = 0.0f;           // fractional particles left over from the last frame
+        std::optional<int> lastDamageFrame;
+        std::optional<int> lastAttackFrame;
+    };
+    void emit(Emitter& emitter, int numParticles);
+    ParticlePool& getPool(SDL_Texture* texture, int layer);
+    float random01();
+
+    std::vector<Emitter> emitters;
+    std::vector<ParticlePool> pools;
+    int liveCount = 0;
+    int maxParticles = 100000;
+    uint32_t randomState = 2463534242u; // fixed seed so replays draw the same particles
+};
+
+#endif /* ParticleSystem_hpp */
@@ -0,0 +1,115 @@
+//
+//  RenderCommandList.cpp
+//  game_engine
+//
+
+#include "RenderCommandList.hpp"
+
+void RenderCommandList::clear() {
+    commands.clear();
+    strings.clear();
+    vertices.clear();
+    rects.clear();
+}
+
+void RenderCommandList::pushClear(SDL_Color color) {
+    RenderCommand command;
+    command.type = RenderCommandType::Clear;
+    command.color = color;
+    commands.push_back(command);
+}
+
+void RenderCommandList::pushSetScale(float scaleX, float scaleY) {
+    RenderCommand command;
+    command.type = RenderCommandType::SetScale;
+    command.scaleX = scaleX;
+    command.scaleY = scaleY;
+    commands.push_back(command);
+}
+
+void RenderCommandList::pushCopy(SDL_Texture* texture, const SDL_Rect& dst) {
+    RenderCommand command;
+    command.type = RenderCommandType::Copy;
+    command.texture = texture;
+    command.dst = dst;
+    commands.push_back(command);
+}
+
+void RenderCommandList::pushCopyEx(int actorID, const std::string& actorName, SDL_Texture* texture, const SDL_Rect& dst, double angle, const SDL_Point& pivot, SDL_RendererFlip flip, const SDL_Rect* src) {
+    RenderCommand command;
+    command.type = RenderCommandType::CopyEx;
+    command.actorID = actorID;
+    command.stringIndex = addString(actorName);
+    command.texture = texture;
+    command.dst = dst;
+    command.angle = angle;
+    command.pivot = pivot;
+    command.flip = flip;
+    if (src) {
+        command.src = *src;
+        command.hasSrc = true;
+    }
+    commands.push_back(command);
+}
+
+void RenderCommandList::pushText(const std::string& text, int x, int y, bool cached) {
+    RenderCommand command;
+    command.type = RenderCommandType::Text;
+    command.cached = cached;
+    command.stringIndex = addString(text);
+    command.dst = {x, y, 0, 0};
+    commands.push_back(command);
+}
+
+SDL_Vertex* RenderCommandList::pushQuads(SDL_Texture* texture, int quadCount) {
+    RenderCommand command;
+    command.type = RenderCommandType::Geometry;
+    command.texture = texture;
+    command.vertexOffset = static_cast<int>(vertices.size());
+    command.quadCount = quadCount;
+    commands.push_back(command);
+
+    for (int quad = static_cast<int>(quadIndices.size()) / 6; quad < quadCount; ++quad) {
+        int first = quad * 4;
+        quadIndices.insert(quadIndices.end(), {first, first + 1, first + 2, first + 2, first + 1, first + 3});
+    }
+    vertices.resize(vertices.size() + static_cast<size_t>(quadCount) * 4);
+    return &vertices[command.vertexOffset];
+}
+
+SDL_FRect* RenderCommandList::pushRects(int rectCount, SDL_Color color, bool filled) {
+    RenderCommand command;
+    command.type = RenderCommandType::DrawRects;
+    command.color = color;
+    command.filled = filled;
+    command.rectOffset = static_cast<int>(rects.size());
+    command.rectCount = rectCount;
+    commands.push_back(command);
+    rects.resize(rects.size() + rectCount);
+    return &rects[command.rectOffset];
+}
+
+const SDL_FRect* RenderCommandList::getRects(int offset) const {
+    return &rects[offset];
+}
+
+const SDL_Vertex* RenderCommandList::getVertices(int offset) const {
+    return &vertices[offset];
+}
+
+const int* RenderCommandList::getQuadIndices() const {
+    return quadIndices.data();
+}
+
+const std::vector<RenderCommand>& RenderCommandList::getCommands() const {
+    return commands;
+}
+
+const std::string& RenderCommandList::getString(int index) const {
+    return strings[index];
+}
+
+int RenderCommandList::addString(const std::string& str) {
+    strings.push_back(str);
+    return static_cast<int>(strings.size()) - 1;
+}
@@ -0,0 +1,80 @@
+//
+//  RenderCommandList.hpp
+//  game_engine
+//
+
+#ifndef RenderCommandList_hpp
+#define RenderCommandList_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#ifdef __APPLE__
+    #include "SDL2/SDL.h"
+#else
+    #include "SDL.h"
+#endif
+
+enum class RenderCommandType {
+    Clear,
+    SetScale,
+    Copy,       // plain SDL_RenderCopy (full screen images, hud icons)
+    CopyEx,     // actor sprites, goes through SDL_RenderCopyEx498
+    Text,
+    Geometry,   // a batch of textured quads, one SDL_RenderGeometry call
+    DrawRects   // a batch of same colored outlines or filled rects, one call
+};
+
+// everything the render thread needs to draw one thing, nothing points back into the simulation
+struct RenderCommand {
+    RenderCommandType type = RenderCommandType::Clear;
+    SDL_Texture* texture = nullptr;
+    SDL_Rect dst = {0, 0, 0, 0};
+    SDL_Rect src = {0, 0, 0, 0};
+    bool hasSrc = false; // false = the whole texture
+    double angle = 0.0;
+    SDL_Point pivot = {0, 0};
+    SDL_RendererFlip flip = SDL_FLIP_NONE;
+    int actorID = 0;
+    int stringIndex = -1; // actor name or text, stored in the list's string table
+    float scaleX = 1.0f;
+    float scaleY = 1.0f;
+    SDL_Color color = {0, 0, 0, 255};
+    int vertexOffset = 0; // geometry only, into the list's vertex buffer
+    int quadCount = 0;
+    int rectOffset = 0;   // rects only, into the list's rect buffer
+    int rectCount = 0;
+    bool filled = false;
+    bool cached = true;   // text only, false for text that changes every frame
+};
+
+// one frame worth of draw commands, recorded by the simulation and consumed by the renderer
+// lists are reused every other frame so their storage only grows until it fits a frame
+class RenderCommandList {
+public:
+    void clear();
+    void pushClear(SDL_Color color);
+    void pushSetScale(float scaleX, float scaleY);
+    void pushCopy(SDL_Texture* texture, const SDL_Rect& dst);
+    void pushCopyEx(int actorID, const std::string& actorName, SDL_Texture* texture, const SDL_Rect& dst, double angle, const SDL_Point& pivot, SDL_RendererFlip flip, const SDL_Rect* src = nullptr);
+    void pushText(const std::string& text, int x, int y, bool cached = true);
+    // returns room for quadCount * 4 vertices to fill in, valid until the next pushQuads
+    SDL_Vertex* pushQuads(SDL_Texture* texture, int quadCount);
+    // returns room for rectCount rects to fill in, valid until the next pushRects
+    SDL_FRect* pushRects(int rectCount, SDL_Color color, bool filled);
+    const std::vector<RenderCommand>& getCommands() const;
+    const std::string& getString(int index) const;
+    const SDL_Vertex* getVertices(int offset) const;
+    const SDL_FRect* getRects(int offset) const;
+    // 0 1 2, 2 1 3 for every quad, relative to a command's first vertex
+    const int* getQuadIndices() const;
+private:
+    int addString(const std::string& str);
+    std::vector<RenderCommand> commands;
+    std::vector<std::string> strings;
+    std::vector<SDL_Vertex> vertices;
+    std::vector<SDL_FRect> rects;
+    std::vector<int> quadIndices; // only grows, shared by every geometry command
+};
+
+#endif /* RenderCommandList_hpp */
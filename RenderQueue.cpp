@@ -0,0 +1,95 @@
+//
+//  RenderQueue.cpp
+//  game_engine
+//
+
+#include "RenderQueue.hpp"
+#include <algorithm>
+#include <cstring>
+
+// below this a comparison sort is cheaper than eight counting passes
+#define RADIX_MIN_ITEMS 256
+
+void RenderQueue::clear() {
+    items.clear();
+    sorted.clear();
+    pushedInIDOrder = true;
+}
+
+void RenderQueue::push(Actor* actor) {
+    if (!items.empty() && items.back().actor->getActorID() > actor->getActorID()) {
+        pushedInIDOrder = false;
+    }
+    items.push_back({makeKey(*actor), actor});
+}
+
+uint64_t RenderQueue::makeKey(const Actor& actor) {
+    int order = actor.getRenderOrder().value_or(static_cast<int>(actor.getPosition().y));
+    // flipping the sign bit makes signed ints sort as unsigned
+    uint32_t orderBits = static_cast<uint32_t>(order) ^ 0x80000000u;
+
+    float y = actor.getPosition().y;
+    if (y == 0.0f) y = 0.0f; // -0 and 0 compare equal, give them the same bits
+    uint32_t yBits;
+    std::memcpy(&yBits, &y, sizeof(yBits));
+    // negative floats sort backwards, so flip all their bits, positive ones just need the sign bit set
+    yBits = (yBits & 0x80000000u) ? ~yBits : (yBits | 0x80000000u);
+
+    return (static_cast<uint64_t>(orderBits) << 32) | yBits;
+}
+
+void RenderQueue::sort() {
+    if (!pushedInIDOrder || items.size() < RADIX_MIN_ITEMS) {
+        std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+            return renderOrderLess(a.actor, b.actor);
+        });
+    }
+    else {
+        // LSD radix sort one byte at a time, skipping bytes every key shares
+        scratch.resize(items.size());
+        for (int shift = 0; shift < 64; shift += 8) {
+            size_t counts[256] = {0};
+            for (const Item& item : items) {
+                counts[(item.key >> shift) & 0xFF]++;
+            }
+            if (counts[(items[0].key >> shift) & 0xFF] == items.size()) continue;
+
+            size_t offset = 0;
+            for (size_t& count : counts) {
+                size_t bucketSize = count;
+                count = offset;
+                offset += bucketSize;
+            }
+            for (const Item& item : items) {
+                scratch[counts[(item.key >> shift) & 0xFF]++] = item;
+            }
+            items.swap(scratch);
+        }
+    }
+    sorted.resize(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        sorted[i] = items[i].actor;
+    }
+}
+
+const std::vector<Actor*>& RenderQueue::getActors() const {
+    return sorted;
+}
+
+bool RenderQueue::renderOrderLess(const Actor* a, const Actor* b) {
+    // Compare using render_order if available; else use transform_position_y
+    int aOrder = a->getRenderOrder().value_or(static_cast<int>(a->getPosition().y));
+    int bOrder = b->getRenderOrder().value_or(static_cast<int>(b->getPosition().y));
+
+    if (aOrder != bOrder) {
+        return aOrder < bOrder;
+    }
+    // if render_order is the same, use y position
+    else if (a->getPosition().y != b->getPosition().y) {
+        return a->getPosition().y < b->getPosition().y;
+    }
+    // if both render_order and y pos are the same, break tie with actorID
+    else {
+        return a->getActorID() < b->getActorID();
+    }
+}
@@ -0,0 +1,37 @@
+//
+//  RenderQueue.hpp
+//  game_engine
+//
+
+#ifndef RenderQueue_hpp
+#define RenderQueue_hpp
+
+#include <stdio.h>
+#include <vector>
+#include <cstdint>
+#include "Actor.hpp"
+
+// orders actors for drawing with a radix sort on one 64 bit key per actor
+// high 32 bits: render_order (else int(y)), low 32 bits: y as order preserving bits
+// the sort is stable, so as long as actors are pushed in actorID order ties come out by actorID
+class RenderQueue {
+public:
+    void clear();
+    void push(Actor* actor);
+    void sort();
+    const std::vector<Actor*>& getActors() const;
+    // render_order if set (else y), then y, then actorID
+    static bool renderOrderLess(const Actor* a, const Actor* b);
+    static uint64_t makeKey(const Actor& actor);
+private:
+    struct Item {
+        uint64_t key;
+        Actor* actor;
+    };
+    std::vector<Item> items;
+    std::vector<Item> scratch;
+    std::vector<Actor*> sorted;
+    bool pushedInIDOrder = true;
+};
+
+#endif /* RenderQueue_hpp */
@@ -0,0 +1,88 @@
+//
+//  RenderThread.cpp
+//  game_engine
+//
+
+#include "RenderThread.hpp"
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+void RenderThread::start(std::function<void(const RenderCommandList&)> executeFrame_in) {
+    if (running) return;
+    executeFrame = executeFrame_in;
+    running = true;
+    thread = std::thread(&RenderThread::run, this);
+}
+
+void RenderThread::submit(const RenderCommandList* list) {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this] { return !busy; });
+    pending = list;
+    busy = true;
+    cv.notify_all();
+}
+
+void RenderThread::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this] { return !busy; });
+}
+
+void RenderThread::stop() {
+    if (!running) return;
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    cv.notify_all();
+    thread.join();
+}
+
+void RenderThread::invoke(std::function<void()> task) {
+    // already on the render thread (e.g. called while drawing), just run it
+    if (std::this_thread::get_id() == thread.get_id()) {
+        task();
+        return;
+    }
+    std::packaged_task<void()> packaged(task);
+    std::future<void> done = packaged.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(packaged));
+    }
+    cv.notify_all();
+    done.wait();
+}
+
+bool RenderThread::isRunning() const {
+    return running;
+}
+
+void RenderThread::run() {
+    while (true) {
+        const RenderCommandList* list = nullptr;
+        std::deque<std::packaged_task<void()>> currentTasks;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this] { return pending != nullptr || !tasks.empty() || !running; });
+            if (!pending && tasks.empty()) break; // stopped with nothing left to do
+            list = pending;
+            pending = nullptr;
+            currentTasks.swap(tasks);
+        }
+        // the submitted frame goes first, tasks may free textures it still uses
+        if (list) {
+            executeFrame(*list);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                busy = false;
+            }
+            cv.notify_all();
+        }
+        for (std::packaged_task<void()>& task : currentTasks) {
+            task();
+        }
+    }
+}
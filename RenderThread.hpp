@@ -0,0 +1,44 @@
+//
+//  RenderThread.hpp
+//  game_engine
+//
+
+#ifndef RenderThread_hpp
+#define RenderThread_hpp
+
+#include <stdio.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <future>
+#include "RenderCommandList.hpp"
+
+// draws one recorded frame at a time while the main thread simulates and records the next one
+// it is the only thread that touches the SDL_Renderer, other threads hand it work through invoke()
+class RenderThread {
+public:
+    ~RenderThread();
+    void start(std::function<void(const RenderCommandList&)> executeFrame);
+    // hands over a finished list, waits first if the previous frame is still being drawn
+    void submit(const RenderCommandList* list);
+    // waits until nothing is being drawn
+    void flush();
+    // runs task on the render thread after any submitted frame and waits for it to finish
+    void invoke(std::function<void()> task);
+    void stop();
+    bool isRunning() const;
+private:
+    void run();
+    std::function<void(const RenderCommandList&)> executeFrame;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable cv;
+    const RenderCommandList* pending = nullptr;
+    std::deque<std::packaged_task<void()>> tasks;
+    bool busy = false;
+    bool running = false;
+};
+
+#endif /* RenderThread_hpp */
@@ -1,5 +1,9 @@
 #include "Renderer.hpp"
 #include "Camera.hpp"
+#include "ThreadPool.hpp"
+#include "ResourceManifest.hpp"
+#include "LoadProfiler.hpp"
+#include <unordered_set>
 
 #define SCENE_UNIT 100
 
@@ -12,10 +16,9 @@ Renderer::Renderer() {
 }
 
 Renderer::~Renderer() {
+    renderThread.stop();
+    frameCapture.stop();
     // Clean up textures
-    for (auto& pair : textures) {
-        SDL_DestroyTexture(pair.second);
-    }
     textures.clear();
 }
 
@@ -42,6 +45,15 @@ void Renderer::LoadLibraries(){
 }
 
 void Renderer::Initialize() {
+    if (useSoftwareBackend) {
+        // no window, everything is rasterized on the cpu into the backend's surface
+        renderer_sdl = softwareBackend.Initialize(width, height);
+        frameCapture.start(width, height);
+        if (useRenderThread) {
+            renderThread.start([this](const RenderCommandList& list) { ExecuteFrame(list); });
+        }
+        return;
+    }
 	// create window
 	SDL_Window* window = Helper::SDL_CreateWindow498(
 		game_title.c_str(),			// window title
@@ -58,27 +70,166 @@ void Renderer::Initialize() {
 		return;
 	}
 
-	// Create renderer for window, first driver available, no flags
-	renderer_sdl = Helper::SDL_CreateRenderer498(window, -1, SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_ACCELERATED);
+	// Create renderer for window, first driver available, vsync only if that's how frames are paced
+	Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+	if (framePacer.getMode() == PacingMode::VSync) {
+		rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+	}
+	renderer_sdl = Helper::SDL_CreateRenderer498(window, -1, rendererFlags);
 	if (renderer_sdl == NULL) {
 		std::cerr << "Renderer could not be created! SDL_Error: " << SDL_GetError() << std::endl;
 	}
+    if (renderer_sdl) {
+        // high dpi displays can have more pixels than the requested resolution
+        int outputWidth = width;
+        int outputHeight = height;
+        SDL_GetRendererOutputSize(renderer_sdl, &outputWidth, &outputHeight);
+        frameCapture.start(outputWidth, outputHeight);
+    }
+    // from here on only the render thread draws, the main thread just records commands
+    if (useRenderThread) {
+        renderThread.start([this](const RenderCommandList& list) { ExecuteFrame(list); });
+    }
+}
+
+RenderCommandList& Renderer::recording() {
+    return commandLists[recordIndex];
 }
 
 void Renderer::StartFrame() {
-    // Initialize renderer color
-    SDL_SetRenderDrawColor(renderer_sdl, std::get<0>(clear_colors), std::get<1>(clear_colors), std::get<2>(clear_colors), 255);
-    // Always clear framebuffer at beginning of frame
-    SDL_RenderClear(renderer_sdl);
-    //std::cout << "buffer cleared" << std::endl;
+    RenderCommandList& list = recording();
+    // Always clear framebuffer at beginning of frame, this also drops anything recorded so far
+    list.clear();
+    SDL_Color clearColor = {static_cast<Uint8>(std::get<0>(clear_colors)), static_cast<Uint8>(std::get<1>(clear_colors)), static_cast<Uint8>(std::get<2>(clear_colors)), 255};
+    list.pushClear(clearColor);
 }
 
 void Renderer::EndFrame() {
+    // nothing changed since the last present, leave the screen as is
+    if (!FrameChanged()) {
+        lastFrameSkipped = true;
+        return;
+    }
+    lastFrameSkipped = false;
+    presentedVersion = contentVersion;
+    if (showFrameStats && font) {
+        // bottom left, on top of everything else
+        std::vector<std::string> lines = framePacer.getSummaryLines();
+        int lineHeight = TTF_FontLineSkip(font);
+        recording().pushSetScale(1.0f, 1.0f);
+        for (int i = 0; i < static_cast<int>(lines.size()); ++i) {
+            recording().pushText(lines[i], 5, height - (static_cast<int>(lines.size()) - i) * lineHeight - 5, false);
+        }
+    }
+    if (renderThread.isRunning()) {
+        // hand the frame over and start recording the next one into the other list
+        renderThread.submit(&recording());
+        recordIndex = 1 - recordIndex;
+    }
+    else {
+        ExecuteFrame(recording());
+    }
+}
+
+void Renderer::FlushFrames() {
+    if (renderThread.isRunning()) {
+        renderThread.flush();
+    }
+}
+
+void Renderer::MarkDirty() {
+    contentVersion++;
+}
+
+bool Renderer::FrameChanged() {
+    return !skipUnchangedFrames || contentVersion != presentedVersion;
+}
+
+bool Renderer::IsIdle() {
+    return lastFrameSkipped;
+}
+
+void Renderer::RunOnDevice(const std::function<void()>& task) {
+    // with a render thread it owns the renderer (and its gl context), so device work goes through it
+    if (renderThread.isRunning()) {
+        renderThread.invoke(task);
+    }
+    else {
+        task();
+    }
+}
+
+void Renderer::ExecuteFrame(const RenderCommandList& list) {
+    Uint64 rasterStart = SDL_GetPerformanceCounter();
+    for (const RenderCommand& command : list.getCommands()) {
+        switch (command.type) {
+            case RenderCommandType::Clear:
+                SDL_SetRenderDrawColor(renderer_sdl, command.color.r, command.color.g, command.color.b, command.color.a);
+                SDL_RenderClear(renderer_sdl);
+                break;
+            case RenderCommandType::SetScale:
+                SDL_RenderSetScale(renderer_sdl, command.scaleX, command.scaleY);
+                break;
+            case RenderCommandType::Copy:
+                SDL_RenderCopy(renderer_sdl, command.texture, NULL, &command.dst);
+                break;
+            case RenderCommandType::CopyEx:
+                Helper::SDL_RenderCopyEx498(command.actorID, list.getString(command.stringIndex), renderer_sdl, command.texture, command.hasSrc ? &command.src : nullptr, &command.dst, command.angle, &command.pivot, command.flip);
+                break;
+            case RenderCommandType::Text: {
+                SDL_Texture* texture = command.cached ? getTextTexture(list.getString(command.stringIndex)) : LoadText(list.getString(command.stringIndex));
+                if (texture) {
+                    int textWidth = 0;
+                    int textHeight = 0;
+                    SDL_QueryTexture(texture, NULL, NULL, &textWidth, &textHeight);
+                    SDL_Rect renderQuad = {command.dst.x, command.dst.y, textWidth, textHeight};
+                    SDL_RenderCopy(renderer_sdl, texture, NULL, &renderQuad);
+                    if (!command.cached) {
+                        SDL_DestroyTexture(texture);
+                    }
+                }
+                break;
+            }
+            case RenderCommandType::DrawRects:
+                SDL_SetRenderDrawColor(renderer_sdl, command.color.r, command.color.g, command.color.b, command.color.a);
+                if (command.filled) {
+                    // filled rects are see-through so the actors under them still show
+                    SDL_BlendMode previousBlendMode = SDL_BLENDMODE_NONE;
+                    SDL_GetRenderDrawBlendMode(renderer_sdl, &previousBlendMode);
+                    SDL_SetRenderDrawBlendMode(renderer_sdl, SDL_BLENDMODE_BLEND);
+                    SDL_RenderFillRectsF(renderer_sdl, list.getRects(command.rectOffset), command.rectCount);
+                    SDL_SetRenderDrawBlendMode(renderer_sdl, previousBlendMode);
+                }
+                else {
+                    SDL_RenderDrawRectsF(renderer_sdl, list.getRects(command.rectOffset), command.rectCount);
+                }
+                break;
+            case RenderCommandType::Geometry:
+                SDL_RenderGeometry(renderer_sdl, command.texture, list.getVertices(command.vertexOffset), command.quadCount * 4, list.getQuadIndices(), command.quadCount * 6);
+                break;
+        }
+    }
+    if (useSoftwareBackend) {
+        double rasterSeconds = static_cast<double>(SDL_GetPerformanceCounter() - rasterStart) / SDL_GetPerformanceFrequency();
+        softwareBackend.captureFrame(Helper::GetFrameNumber(), rasterSeconds);
+    }
+    if (frameCapture.isActive()) {
+        frameCapture.grab(renderer_sdl, Helper::GetFrameNumber());
+    }
     // Update screen
+    framePacer.beginPresent();
     Helper::SDL_RenderPresent498(renderer_sdl);
+    framePacer.endPresent(Helper::GetFrameNumber());
+    framePacer.waitForNextFrame();
+}
+
+void Renderer::SetScale(float scaleX, float scaleY) {
+    recording().pushSetScale(scaleX, scaleY);
 }
 
 void Renderer::Cleanup() {
+    renderThread.stop();
+    frameCapture.stop();
     //Mix_Quit();
     TTF_Quit();
     SDL_Quit();
@@ -102,19 +253,34 @@ void Renderer::ProcessEvents() {
     }
 }
 
-SDL_Texture* Renderer::LoadImage(const std::string& imageName) {
-    std::string imagePath = "resources/images/" + imageName + ".png";
+SDL_Texture* Renderer::LoadImage(const std::string& imageName, uint64_t& contentHash) {
+    std::optional<ResourceEntry> entry = ResourceManifest::find(ResourceType::Image, imageName);
     // if file path doesn't exist, exit
-    if (!std::filesystem::exists(imagePath)){
+    if (!entry.has_value()){
         std::cout << "error: missing image " << imageName;
         exit(0);
     }
-    SDL_Texture* texture = IMG_LoadTexture(renderer_sdl, imagePath.c_str());
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    ImageSource source;
+    bool read = ReadImage(*entry, source);
+    contentHash = source.contentHash;
+    if (read) {
+        std::lock_guard<std::mutex> cacheLock(cacheMutex);
+        SDL_Texture* texture = textures.findByHash(contentHash);
+        if (texture) {
+            // a copy of a resident image, the bytes are only needed for the hash
+            SDL_RWclose(source.rw);
+            LoadProfiler::recordAsset(AssetKind::Image, imageName, 0, 0.0, true);
+            return texture;
+        }
+    }
+    SDL_Texture* texture = read ? IMG_LoadTexture_RW(renderer_sdl, source.rw, 1) : nullptr;
     // if no texture was able to load, exit
     if (!texture) {
         std::cerr << "error: image failed to load " << imageName << ". SDL Error: " << IMG_GetError();
         exit(0);
     }
+    LoadProfiler::recordAsset(AssetKind::Image, imageName, entry->size, LoadProfiler::millisecondsSince(start), false);
     return texture;
 }
 
@@ -137,21 +303,299 @@ SDL_Texture* Renderer::LoadText(const std::string& text) {
 
     return textTexture;
 }
-SDL_Texture* Renderer::getImagePointer(const std::string& imageName){
-    // Load and cache texture if not already loaded
-    if (textures.find(imageName) == textures.end()) {
-        textures[imageName] = LoadImage(imageName);
+SDL_Texture* Renderer::getImagePointer(const std::string& imageName, const std::string& owner){
+    {
+        std::lock_guard<std::mutex> cacheLock(cacheMutex);
+        SDL_Texture* texture = textures.find(imageName);
+        if (texture) {
+            // owned textures stay resident until their scene or template lets go of them
+            if (owner != "") {
+                textures.retain(imageName, owner);
+            }
+            LoadProfiler::recordAsset(AssetKind::Image, imageName, 0, 0.0, true);
+            return texture;
+        }
+    }
+    // a copy of an image that's already resident shares its texture, once its file has been hashed nothing is read
+    uint64_t contentHash = getImageHash(imageName);
+    {
+        std::lock_guard<std::mutex> cacheLock(cacheMutex);
+        SDL_Texture* texture = textures.findByHash(contentHash);
+        if (texture) {
+            textures.insert(imageName, texture, contentHash);
+            if (owner != "") {
+                textures.retain(imageName, owner);
+            }
+            LoadProfiler::recordAsset(AssetKind::Image, imageName, 0, 0.0, true);
+            return texture;
+        }
+    }
+    // Load and cache texture if not already loaded (inserting can evict, which also needs the device)
+    SDL_Texture* texture = nullptr;
+    RunOnDevice([&] {
+        // hashed the first time it's read, LoadImage hands back the resident texture if it's a copy
+        texture = LoadImage(imageName, contentHash);
+        std::lock_guard<std::mutex> cacheLock(cacheMutex);
+        textures.insert(imageName, texture, contentHash);
+        if (owner != "") {
+            textures.retain(imageName, owner);
+        }
+    });
+    return texture;
+}
+
+ImageReloadResult Renderer::reloadImage(const std::string& imageName) {
+    SDL_Texture* texture = nullptr;
+    bool shared = false;
+    {
+        std::lock_guard<std::mutex> cacheLock(cacheMutex);
+        texture = textures.peek(imageName);
+        shared = textures.isShared(imageName);
+    }
+    if (!texture) return ImageReloadResult::Unchanged;
+    Uint32 format = 0;
+    int w = 0;
+    int h = 0;
+    SDL_QueryTexture(texture, &format, nullptr, &w, &h);
+    // decoded straight into the texture's own format so the pixels can be copied over as they are
+    SDL_Surface* surface = DecodeImage(imageName, format);
+    if (!surface) {
+        std::cerr << "error: image failed to reload " << imageName << std::endl;
+        return ImageReloadResult::Unchanged;
+    }
+    uint64_t contentHash = getImageHash(imageName);
+    ImageReloadResult result = ImageReloadResult::Unchanged;
+    RunOnDevice([&] {
+        // every actor, template and baked chunk keeps pointing at the same texture
+        // unless other images share it, they keep the old pixels and this one gets its own
+        if (!shared && surface->w == w && surface->h == h && SDL_UpdateTexture(texture, nullptr, surface->pixels, surface->pitch) == 0) {
+            std::lock_guard<std::mutex> cacheLock(cacheMutex);
+            textures.rehash(imageName, contentHash);
+            result = ImageReloadResult::UpdatedInPlace;
+        }
+        else {
+            SDL_Texture* replacement = SDL_CreateTextureFromSurface(renderer_sdl, surface);
+            if (replacement) {
+                std::lock_guard<std::mutex> cacheLock(cacheMutex);
+                SDL_Texture* retired = textures.replace(imageName, replacement);
+                if (retired) {
+                    retiredTextures.push_back(retired);
+                }
+                textures.rehash(imageName, contentHash);
+                result = ImageReloadResult::Replaced;
+            }
+        }
+        SDL_FreeSurface(surface);
+    });
+    MarkDirty();
+    return result;
+}
+
+void Renderer::destroyRetiredTextures() {
+    // goes after any frame already handed to the render thread, which may still draw with them
+    RunOnDevice([this] {
+        for (SDL_Texture* texture : retiredTextures) {
+            SDL_DestroyTexture(texture);
+        }
+        retiredTextures.clear();
+    });
+}
+
+SDL_Surface* Renderer::DecodeImage(const std::string& imageName, Uint32 format) {
+    // safe to call from any thread, nothing here touches the renderer
+    std::optional<ResourceEntry> entry = ResourceManifest::find(ResourceType::Image, imageName);
+    if (!entry.has_value()) {
+        return nullptr;
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    // hashed here, on the worker, from the same bytes that are decoded
+    // so uploading and later loads can find copies without reading the file
+    ImageSource source;
+    if (!ReadImage(*entry, source)) {
+        return nullptr;
+    }
+    SDL_Surface* decoded = IMG_Load_RW(source.rw, 1);
+    if (!decoded) {
+        return nullptr;
+    }
+    SDL_Surface* converted = decoded;
+    if (decoded->format->format != format) {
+        converted = SDL_ConvertSurfaceFormat(decoded, format, 0);
+        SDL_FreeSurface(decoded);
+    }
+    LoadProfiler::recordAsset(AssetKind::Image, imageName, entry->size, LoadProfiler::millisecondsSince(start), false);
+    return converted;
+}
+
+Uint32 Renderer::getUploadFormat() {
+    // the first format the renderer takes natively that keeps alpha, so uploads are a straight copy
+    SDL_RendererInfo info;
+    if (renderer_sdl && SDL_GetRendererInfo(renderer_sdl, &info) == 0) {
+        for (Uint32 i = 0; i < info.num_texture_formats; ++i) {
+            Uint32 format = info.texture_formats[i];
+            if (SDL_ISPIXELFORMAT_ALPHA(format) && !SDL_ISPIXELFORMAT_FOURCC(format)) {
+                return format;
+            }
+        }
+    }
+    return SDL_PIXELFORMAT_ARGB8888;
+}
+
+uint64_t Renderer::getImageHash(const std::string& imageName) {
+    std::optional<ResourceEntry> entry = ResourceManifest::find(ResourceType::Image, imageName);
+    if (!entry.has_value()) return 0;
+    return ResourceManifest::findContentHash(*entry).value_or(0);
+}
+
+bool Renderer::ReadImage(const ResourceEntry& entry, ImageSource& source) {
+    // safe on any thread
+    if (entry.data) {
+        // packed files are hashed and decoded straight from the mapping
+        source.contentHash = ResourceManifest::contentHash(entry);
+        source.rw = SDL_RWFromConstMem(entry.data, static_cast<int>(entry.size));
+        return source.rw != nullptr;
+    }
+    SDL_RWops* file = SDL_RWFromFile(entry.path.c_str(), "rb");
+    if (!file) return false;
+    Sint64 fileSize = SDL_RWsize(file);
+    source.buffer.resize(fileSize > 0 ? static_cast<size_t>(fileSize) : 0);
+    size_t count = source.buffer.empty() ? 0 : SDL_RWread(file, source.buffer.data(), 1, source.buffer.size());
+    SDL_RWclose(file);
+    source.buffer.resize(count);
+    if (source.buffer.empty()) return false;
+    source.contentHash = ResourceManifest::contentHash(entry, source.buffer.data(), source.buffer.size());
+    source.rw = SDL_RWFromConstMem(source.buffer.data(), static_cast<int>(source.buffer.size()));
+    return source.rw != nullptr;
+}
+
+std::vector<std::string> Renderer::findMissingImages(const std::vector<std::string>& imageNames) {
+    // only what isn't resident yet, once per name
+    // and once per content where it's been hashed before, getImagePointer hands the copies the same texture
+    std::vector<uint64_t> hashes;
+    hashes.reserve(imageNames.size());
+    for (const std::string& imageName : imageNames) {
+        hashes.push_back(getImageHash(imageName));
+    }
+    std::vector<std::string> missing;
+    std::unordered_set<std::string> seen;
+    std::unordered_set<uint64_t> seenHashes;
+    std::lock_guard<std::mutex> cacheLock(cacheMutex);
+    for (size_t i = 0; i < imageNames.size(); ++i) {
+        const std::string& imageName = imageNames[i];
+        if (textures.contains(imageName) || !seen.insert(imageName).second) continue;
+        if (hashes[i] != 0 && (textures.findByHash(hashes[i]) || !seenHashes.insert(hashes[i]).second)) continue;
+        missing.push_back(imageName);
+    }
+    return missing;
+}
+
+void Renderer::PreloadImages(const std::vector<std::string>& imageNames) {
+    std::vector<std::string> missing = findMissingImages(imageNames);
+    if (missing.empty()) return;
+
+    // stage 1: decode and convert on the worker pool
+    Uint32 format = getUploadFormat();
+    std::vector<DecodedImage> images(missing.size());
+    ThreadPool::shared().parallelFor(missing.size(), [&](size_t i) {
+        images[i].name = missing[i];
+        images[i].surface = DecodeImage(missing[i], format);
+    });
+
+    // stage 2: upload on the device thread
+    UploadImages(images);
+}
+
+std::vector<DecodedImage> Renderer::DecodeMissingImages(const std::vector<std::string>& imageNames, Uint32 format) {
+    // one image after another, this already runs on a worker
+    std::vector<DecodedImage> images;
+    for (const std::string& imageName : findMissingImages(imageNames)) {
+        SDL_Surface* surface = DecodeImage(imageName, format);
+        if (surface) {
+            images.push_back({imageName, surface});
+        }
+    }
+    return images;
+}
+
+void Renderer::UploadImages(std::vector<DecodedImage>& images) {
+    // anything that failed to decode is left for getImagePointer, which reports the error
+    RunOnDevice([&] {
+        for (DecodedImage& image : images) {
+            if (!image.surface) continue;
+            bool resident = false;
+            // decoding hashed it
+            uint64_t contentHash = getImageHash(image.name);
+            {
+                // another loader may have brought it in since it was decoded, or a copy of it
+                std::lock_guard<std::mutex> cacheLock(cacheMutex);
+                resident = textures.contains(image.name);
+                SDL_Texture* shared = resident ? nullptr : textures.findByHash(contentHash);
+                if (shared) {
+                    textures.insert(image.name, shared, contentHash);
+                    resident = true;
+                }
+            }
+            SDL_Texture* texture = resident ? nullptr : SDL_CreateTextureFromSurface(renderer_sdl, image.surface);
+            if (texture) {
+                std::lock_guard<std::mutex> cacheLock(cacheMutex);
+                textures.insert(image.name, texture, contentHash);
+            }
+            SDL_FreeSurface(image.surface);
+            image.surface = nullptr;
+        }
+    });
+}
+
+SDL_Texture* Renderer::getTextTexture(const std::string& text){
+    // only called while drawing a frame, so this is already the device thread
+    // text shares the cache with images but is never owned, so it is the first to go
+    std::string key = "text:" + text;
+    std::lock_guard<std::mutex> cacheLock(cacheMutex);
+    SDL_Texture* texture = textures.find(key);
+    if (!texture) {
+        texture = LoadText(text);
+        textures.insert(key, texture);
     }
-    SDL_Texture* texture = textures[imageName];
     return texture;
 }
 
+void Renderer::releaseTextures(const std::string& owner){
+    std::lock_guard<std::mutex> cacheLock(cacheMutex);
+    textures.releaseOwner(owner);
+}
+
+void Renderer::evictUnusedTextures(){
+    // runs after the frame in flight, which may still be drawing with textures that are about to go
+    RunOnDevice([&] {
+        std::lock_guard<std::mutex> cacheLock(cacheMutex);
+        textures.evictUnreferenced();
+    });
+}
+
+void Renderer::setTextureBudget(size_t budgetBytes){
+    RunOnDevice([&] {
+        std::lock_guard<std::mutex> cacheLock(cacheMutex);
+        textures.setBudget(budgetBytes);
+    });
+}
+
+void Renderer::setTextureReport(bool shouldReport){
+    textureReport = shouldReport;
+}
+
+void Renderer::printTextureStats(){
+    if (textureReport) {
+        std::lock_guard<std::mutex> cacheLock(cacheMutex);
+        textures.printStats(std::cout);
+    }
+}
+
 void Renderer::RenderImage(const std::string& imageName) {
     SDL_Texture* texture = getImagePointer(imageName);
     if (texture) {
         // Render the texture
         SDL_Rect dstRect = {0, 0, width, height};
-        SDL_RenderCopy(renderer_sdl, texture, NULL, &dstRect);
+        recording().pushCopy(texture, dstRect);
         //std::cout << "rendered image " << imageName << std::endl;
     }
 }
@@ -165,9 +609,16 @@ void Renderer::RenderActor(Actor& actor, glm::vec2 cameraPosition, double zoomFa
         currDirection = actor.getXDirection();
     }
     SDL_Texture* texture = actor.getViewImage();
+    const SDL_Rect* frame = actor.getViewFrame();
     // could store in actor class to decrease num of function calls
     int textureWidth, textureHeight;
-    SDL_QueryTexture(texture, nullptr, nullptr, &textureWidth, &textureHeight);
+    if (frame) {
+        textureWidth = frame->w;
+        textureHeight = frame->h;
+    }
+    else {
+        SDL_QueryTexture(texture, nullptr, nullptr, &textureWidth, &textureHeight);
+    }
 
     SDL_Rect dstRect;
     SDL_Point* pivotPoint = actor.getPivotSDLPoint();
@@ -192,47 +643,49 @@ void Renderer::RenderActor(Actor& actor, glm::vec2 cameraPosition, double zoomFa
         }
     }
     
-    Helper::SDL_RenderCopyEx498(actor.getActorID(), actor.getActorName(), renderer_sdl, actor.getViewImage(), nullptr, &dstRect, actor.getTransformRotationDegrees(), pivotPoint, currFlip);
+    recording().pushCopyEx(actor.getActorID(), actor.getActorName(), texture, dstRect, actor.getTransformRotationDegrees(), *pivotPoint, currFlip, frame);
     
 }
 
-void Renderer::RenderCollider(Actor &actor, glm::vec2 cameraPosition, const Collider &collider){
-    // Set the renderer's draw color to red
-    SDL_SetRenderDrawColor(renderer_sdl, 255, 0, 0, SDL_ALPHA_OPAQUE); // RGBA
+void Renderer::RenderDebugRects(const std::vector<SDL_FRect>& worldRects, SDL_Color color, bool filled, glm::vec2 cameraPosition, double zoomFactor){
+    // same transform as RenderActor, the zoom itself comes from the render scale
+    float viewWidth = static_cast<float>(width / zoomFactor);
+    float viewHeight = static_cast<float>(height / zoomFactor);
+    float offsetX = viewWidth * 0.5f - cameraPosition.x * SCENE_UNIT;
+    float offsetY = viewHeight * 0.5f - cameraPosition.y * SCENE_UNIT;
+
+    debugRects.clear();
+    for (const SDL_FRect& rect : worldRects) {
+        SDL_FRect screenRect = {rect.x * SCENE_UNIT + offsetX, rect.y * SCENE_UNIT + offsetY, rect.w * SCENE_UNIT, rect.h * SCENE_UNIT};
+        // off screen rects would only cost time
+        if (screenRect.x > viewWidth || screenRect.y > viewHeight || screenRect.x + screenRect.w < 0 || screenRect.y + screenRect.h < 0) continue;
+        debugRects.push_back(screenRect);
+    }
+    if (debugRects.empty()) return;
+    SDL_FRect* rects = recording().pushRects(static_cast<int>(debugRects.size()), color, filled);
+    std::copy(debugRects.begin(), debugRects.end(), rects);
+}
 
-    // Calculate the screen position of the collider
-    SDL_Rect colliderRect;
-    colliderRect.x = static_cast<int>((collider.left - cameraPosition.x) * SCENE_UNIT + (width / 2));
-    colliderRect.y = static_cast<int>((collider.top - cameraPosition.y) * SCENE_UNIT + (height / 2));
-    colliderRect.w = static_cast<int>(collider.width * SCENE_UNIT);
-    colliderRect.h = static_cast<int>(collider.height * SCENE_UNIT);
+void Renderer::getStaticLayerCells(std::vector<SDL_FRect>& cells){
+    staticLayer.getChunkCells(cells);
+}
 
-    // Draw the collider rectangle
-    SDL_RenderDrawRect(renderer_sdl, &colliderRect);
+void Renderer::setDebugOverlay(bool showOverlay){
+    debugOverlay = showOverlay;
+    MarkDirty();
+}
 
-    SDL_SetRenderDrawColor(renderer_sdl, std::get<0>(clear_colors), std::get<1>(clear_colors), std::get<2>(clear_colors), 255);
+bool Renderer::getDebugOverlay(){
+    return debugOverlay;
 }
 
 void Renderer::RenderText(const std::string& text, int x, int y){
-    if (textures.find(text) == textures.end()) {
-        textures[text] = LoadText(text);
-    }
-    SDL_Texture* texture = textures[text];
-    if (texture) {
-        // Render the texture
-        int textWidth = 0;
-        int textHeight = 0;
-        SDL_QueryTexture(texture, NULL, NULL, &textWidth, &textHeight);
-        SDL_Rect renderQuad = {x, y, textWidth, textHeight};
-
-        // Render the texture to the renderer
-        SDL_RenderCopy(renderer_sdl, texture, NULL, &renderQuad);
-        //std::cout << "rendered text " << text << std::endl;
-    }
+    // the texture is looked up (and created if needed) when the frame is drawn
+    recording().pushText(text, x, y);
 }
 
 void Renderer::RenderHUD(const std::string& hp_image, int health, int score){
-    SDL_RenderSetScale(renderer_sdl, 1.0, 1.0);
+    SetScale(1.0, 1.0);
     SDL_Texture* hpTexture = getImagePointer(hp_image);
     // Query the health icon texture to get its width and height
     int imgWidth, imgHeight;
@@ -243,7 +696,7 @@ void Renderer::RenderHUD(const std::string& hp_image, int health, int score){
         int x = 5 + i * (imgWidth + 5);
         int y = 25;
         SDL_Rect dstRect = {x, y, imgWidth, imgHeight};
-        SDL_RenderCopy(renderer_sdl, hpTexture, NULL, &dstRect);
+        recording().pushCopy(hpTexture, dstRect);
         //std::cout << "rendered img " << hp_image << std::endl;
     }
     
@@ -253,6 +706,40 @@ void Renderer::RenderHUD(const std::string& hp_image, int health, int score){
     
 }
 
+bool Renderer::BakeStaticLayer(const std::vector<Actor*>& actors){
+    // baking draws into render targets, so it has to happen between frames
+    bool baked = false;
+    RunOnDevice([&] {
+        baked = staticLayer.bake(renderer_sdl, actors);
+    });
+    return baked;
+}
+
+void Renderer::RenderParticles(const ParticlePool& pool, glm::vec2 cameraPosition, double zoomFactor){
+    if (pool.count() == 0) return;
+    SDL_Vertex* vertices = recording().pushQuads(pool.texture, pool.count());
+    pool.buildQuads(vertices, cameraPosition, static_cast<float>((width * 0.5) / zoomFactor), static_cast<float>((height * 0.5) / zoomFactor));
+}
+
+void Renderer::RenderStaticLayer(glm::vec2 cameraPosition, double zoomFactor){
+    staticLayer.render(recording(), cameraPosition, zoomFactor, width, height);
+}
+
+void Renderer::ClearStaticLayer(){
+    RunOnDevice([&] {
+        staticLayer.clear();
+    });
+}
+
+void Renderer::setStaticLayer(std::optional<int> renderOrderThreshold, int chunkSize){
+    staticLayerThreshold = renderOrderThreshold;
+    staticLayer.setChunkSize(chunkSize);
+}
+
+std::optional<int> Renderer::getStaticLayerThreshold(){
+    return staticLayerThreshold;
+}
+
 void Renderer::setGameTitle(const std::string& title_in) {
 	game_title = title_in;
 }
@@ -274,6 +761,34 @@ void Renderer::setFont(TTF_Font* font_in){
     font = font_in;
 }
 
+void Renderer::setRenderThread(bool useRenderThread_in){
+    useRenderThread = useRenderThread_in;
+}
+
+void Renderer::setSkipUnchangedFrames(bool shouldSkip){
+    skipUnchangedFrames = shouldSkip;
+}
+
+void Renderer::setSoftwareRender(bool useSoftwareBackend_in){
+    useSoftwareBackend = useSoftwareBackend_in;
+}
+
+SoftwareBackend& Renderer::getSoftwareBackend(){
+    return softwareBackend;
+}
+
+FrameCapture& Renderer::getFrameCapture(){
+    return frameCapture;
+}
+
+FramePacer& Renderer::getFramePacer(){
+    return framePacer;
+}
+
+void Renderer::setFrameStatsOverlay(bool showStats){
+    showFrameStats = showStats;
+}
+
 SDL_Renderer* Renderer::getRendererSDL(){
     return renderer_sdl;
 }
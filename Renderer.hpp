@@ -5,6 +5,7 @@
 #include <string>
 #include <iostream>
 #include <cmath>
+#include <mutex>
 #include "glm/glm.hpp"
 #include "Directions.hpp"
 
@@ -25,19 +26,80 @@
 #endif
 
 #include "Actor.hpp"
+#include "TextureCache.hpp"
+#include "RenderCommandList.hpp"
+#include "RenderThread.hpp"
+#include "SoftwareBackend.hpp"
+#include "StaticLayer.hpp"
+#include "ParticleSystem.hpp"
+#include "FrameCapture.hpp"
+#include "FramePacer.hpp"
 class Camera;
+struct ResourceEntry;
+
+enum class ImageReloadResult {
+    Unchanged,      // not resident or failed to decode, nothing to do
+    UpdatedInPlace, // same size, pixels replaced inside the existing texture
+    Replaced        // new texture, anything holding the old pointer has to look the image up again
+};
+
+// an image decoded off the device thread, waiting to be uploaded
+struct DecodedImage {
+    std::string name;
+    SDL_Surface* surface = nullptr;
+};
+
 class Renderer
 {
 private:
     bool shouldMovementFlip = false;
-	std::unordered_map<std::string, SDL_Texture*> textures;
+	TextureCache textures;
 	std::string game_title = "";
 	int width = 640;
 	int height = 360;
 	std::tuple<int, int, int> clear_colors = std::make_tuple(255, 255, 255);
 	SDL_Renderer* renderer_sdl;
-    TTF_Font* font;
+    TTF_Font* font = nullptr;
     SDL_Color textColor = {255, 255, 255, 255}; // white
+    bool textureReport = false;
+    // simulation records into one list while the other one is being drawn
+    RenderCommandList commandLists[2];
+    int recordIndex = 0;
+    RenderThread renderThread;
+    bool useRenderThread = false;
+    // headless rendering into a surface for regression and perf runs
+    SoftwareBackend softwareBackend;
+    bool useSoftwareBackend = false;
+    FrameCapture frameCapture;
+    bool debugOverlay = false;
+    FramePacer framePacer;
+    bool showFrameStats = false;
+    std::vector<SDL_FRect> debugRects;
+    // background scenery of the current scene, baked into chunk textures
+    StaticLayer staticLayer;
+    std::optional<int> staticLayerThreshold; // unset = no baking
+    // bumped whenever something that changes the picture happens, frames with no bump aren't drawn
+    uint64_t contentVersion = 1;
+    uint64_t presentedVersion = 0;
+    bool skipUnchangedFrames = false;
+    bool lastFrameSkipped = false;
+    // the main thread looks textures up while the render thread creates text textures
+    std::mutex cacheMutex;
+    // swapped out by hot reload, destroyed once nothing can be drawing with them
+    std::vector<SDL_Texture*> retiredTextures;
+    RenderCommandList& recording();
+    void ExecuteFrame(const RenderCommandList& list);
+    void RunOnDevice(const std::function<void()>& task);
+    SDL_Texture* getTextTexture(const std::string& text);
+    // the manifest's content hash of the image file, 0 if it's missing or hasn't been read yet
+    static uint64_t getImageHash(const std::string& imageName);
+    // an image file read once, hashed, and decoded from memory
+    struct ImageSource {
+        std::vector<char> buffer;   // loose files only, packed ones are decoded straight from the mapping
+        SDL_RWops* rw = nullptr;    // over the buffer or the mapping, freed by whoever decodes it
+        uint64_t contentHash = 0;
+    };
+    static bool ReadImage(const ResourceEntry& entry, ImageSource& source);
 public:
     Renderer();
     ~Renderer();
@@ -45,24 +107,64 @@ public:
 	void Initialize();
 	void StartFrame();
 	void EndFrame();
+    void FlushFrames();
+    void MarkDirty();
+    bool FrameChanged();
+    bool IsIdle();
+    void SetScale(float scaleX, float scaleY);
 	void Cleanup();
     void ProcessEvents();
-    SDL_Texture* LoadImage(const std::string& imageName);
+    // contentHash is set to the file's hash, a copy of a resident image gets that texture back instead of a new one
+    SDL_Texture* LoadImage(const std::string& imageName, uint64_t& contentHash);
     SDL_Texture* LoadText(const std::string& text);
-    SDL_Texture* getImagePointer(const std::string& imageName);
+    static SDL_Surface* DecodeImage(const std::string& imageName, Uint32 format);
+    void PreloadImages(const std::vector<std::string>& imageNames);
+    // the two stages of PreloadImages for loaders that decode on a worker and upload later
+    // DecodeMissingImages is safe on any thread, UploadImages takes (and nulls) the surfaces
+    std::vector<DecodedImage> DecodeMissingImages(const std::vector<std::string>& imageNames, Uint32 format);
+    // the names that aren't resident yet, each once
+    std::vector<std::string> findMissingImages(const std::vector<std::string>& imageNames);
+    void UploadImages(std::vector<DecodedImage>& images);
+    Uint32 getUploadFormat();
+    SDL_Texture* getImagePointer(const std::string& imageName, const std::string& owner = "");
+    void releaseTextures(const std::string& owner);
+    void evictUnusedTextures();
+    void setTextureBudget(size_t budgetBytes);
+    void setTextureReport(bool shouldReport);
+    void printTextureStats();
+    // re-decodes a changed image file into the resident texture
+    ImageReloadResult reloadImage(const std::string& imageName);
+    void destroyRetiredTextures();
 	void RenderImage(const std::string& imageName);
 	void RenderText(const std::string& text, int x, int y);
 	void RenderActor(Actor& actor, glm::vec2 cameraPosition, double zoomFactor);
 	void RenderHUD(const std::string& hp_image, int health, int score);
+    bool BakeStaticLayer(const std::vector<Actor*>& actors);
+    void RenderStaticLayer(glm::vec2 cameraPosition, double zoomFactor);
+    void RenderParticles(const ParticlePool& pool, glm::vec2 cameraPosition, double zoomFactor);
+    void ClearStaticLayer();
+    void setStaticLayer(std::optional<int> renderOrderThreshold, int chunkSize);
+    std::optional<int> getStaticLayerThreshold();
 	void setGameTitle(const std::string& title_in);
 	void setWidth(int width_in);
 	void setHeight(int height_in);
     void setMovementFlip(bool shouldMovementFlip);
 	void setClearColors(int r, int g, int b);
     void setFont(TTF_Font* font_in);
+    void setRenderThread(bool useRenderThread);
+    void setSkipUnchangedFrames(bool shouldSkip);
+    void setSoftwareRender(bool useSoftwareBackend);
+    SoftwareBackend& getSoftwareBackend();
+    FrameCapture& getFrameCapture();
+    FramePacer& getFramePacer();
+    void setFrameStatsOverlay(bool showStats);
     int getHeight();
     int getWidth();
     SDL_Renderer* getRendererSDL();
-    void RenderCollider(Actor &actor, glm::vec2 cameraPosition, const Collider &collider);
+    // rects are in scene units, drawn with one call for the whole batch
+    void RenderDebugRects(const std::vector<SDL_FRect>& worldRects, SDL_Color color, bool filled, glm::vec2 cameraPosition, double zoomFactor);
+    void getStaticLayerCells(std::vector<SDL_FRect>& cells);
+    void setDebugOverlay(bool showOverlay);
+    bool getDebugOverlay();
 };
 #endif
@@ -0,0 +1,239 @@
+//
+//  ResourceManifest.cpp
+//  game_engine
+//
+
+#include "ResourceManifest.hpp"
+#include <iostream>
+#include <filesystem>
+#include <mutex>
+
+std::shared_mutex ResourceManifest::mutex;
+std::string ResourceManifest::root = "resources";
+std::unordered_map<std::string, ResourceEntry> ResourceManifest::index[RESOURCE_TYPE_COUNT];
+std::unordered_map<std::string, ResourceEntry> ResourceManifest::byPath;
+bool ResourceManifest::rescanOnMiss = false;
+PackArchive ResourceManifest::pack;
+std::mutex ResourceManifest::hashMutex;
+std::unordered_map<std::string, ResourceManifest::CachedHash> ResourceManifest::hashes;
+
+void ResourceManifest::scan(const std::string& root_in) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    root = root_in;
+    scanLocked();
+}
+
+void ResourceManifest::rescan() {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    scanLocked();
+}
+
+void ResourceManifest::setRescanOnMiss(bool enabled) {
+    rescanOnMiss = enabled;
+}
+
+bool ResourceManifest::mountPack(const std::string& path) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    bool mounted = pack.mount(path);
+    scanLocked();
+    return mounted;
+}
+
+bool ResourceManifest::isPackMounted() {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return pack.isMounted();
+}
+
+void ResourceManifest::scanLocked() {
+    for (auto& typeIndex : index) {
+        typeIndex.clear();
+    }
+    byPath.clear();
+
+    for (const PackArchive::Entry& packEntry : pack.getEntries()) {
+        ResourceEntry entry;
+        entry.path = packEntry.path;
+        entry.size = packEntry.size;
+        entry.data = packEntry.data;
+        addEntry(entry);
+    }
+
+    std::error_code error;
+    std::filesystem::recursive_directory_iterator it(root, std::filesystem::directory_options::skip_permission_denied, error);
+    if (error) return;
+    for (; it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+        if (error) break;
+        std::error_code entryError;
+        if (!it->is_regular_file(entryError)) continue;
+
+        ResourceEntry entry;
+        // '/' separated so keys match the paths the loaders build on every platform
+        entry.path = it->path().generic_string();
+        entry.size = it->file_size(entryError);
+        entry.modified = it->last_write_time(entryError);
+        addEntry(entry);
+    }
+}
+
+void ResourceManifest::identify(const std::string& path, ResourceType& type, std::string& name) {
+    std::string relativePath = std::filesystem::path(path).lexically_relative(root).generic_string();
+    classify(relativePath, type, name);
+}
+
+void ResourceManifest::addEntry(const ResourceEntry& entry_in) {
+    ResourceEntry entry = entry_in;
+    std::string name;
+    identify(entry.path, entry.type, name);
+
+    std::unordered_map<std::string, ResourceEntry>& typeIndex = index[static_cast<int>(entry.type)];
+    auto existing = typeIndex.find(name);
+    // a sound can be a .wav or an .ogg, the .wav wins like it always has
+    bool keepExisting = existing != typeIndex.end() && entry.type == ResourceType::Audio
+        && std::filesystem::path(existing->second.path).extension() == ".wav"
+        && std::filesystem::path(entry.path).extension() != ".wav";
+    if (!keepExisting) {
+        typeIndex[name] = entry;
+    }
+    byPath[entry.path] = entry;
+}
+
+void ResourceManifest::classify(const std::string& relativePath, ResourceType& type, std::string& name) {
+    std::filesystem::path path(relativePath);
+    std::string extension = path.extension().string();
+    size_t slash = relativePath.find('/');
+    if (slash == std::string::npos) {
+        type = ResourceType::Config;
+        name = relativePath;
+        return;
+    }
+    std::string directory = relativePath.substr(0, slash);
+    std::string inner = relativePath.substr(slash + 1);
+    std::string stem = inner.substr(0, inner.size() - extension.size());
+    if (directory == "images" && extension == ".png") type = ResourceType::Image;
+    else if (directory == "audio" && (extension == ".wav" || extension == ".ogg")) type = ResourceType::Audio;
+    else if (directory == "scenes" && extension == ".scene") type = ResourceType::Scene;
+    else if (directory == "actor_templates" && extension == ".template") type = ResourceType::Template;
+    else if (directory == "fonts" && extension == ".ttf") type = ResourceType::Font;
+    else {
+        type = ResourceType::Other;
+        name = relativePath;
+        return;
+    }
+    name = stem;
+}
+
+bool ResourceManifest::rescanAfterMiss() {
+    if (!rescanOnMiss) return false;
+    rescan();
+    return true;
+}
+
+std::optional<ResourceEntry> ResourceManifest::find(ResourceType type, const std::string& name) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        const std::unordered_map<std::string, ResourceEntry>& typeIndex = index[static_cast<int>(type)];
+        auto it = typeIndex.find(name);
+        if (it != typeIndex.end()) return it->second;
+    }
+    if (!rescanAfterMiss()) return std::nullopt;
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    const std::unordered_map<std::string, ResourceEntry>& typeIndex = index[static_cast<int>(type)];
+    auto it = typeIndex.find(name);
+    if (it != typeIndex.end()) return it->second;
+    return std::nullopt;
+}
+
+bool ResourceManifest::contains(ResourceType type, const std::string& name) {
+    return find(type, name).has_value();
+}
+
+std::optional<ResourceEntry> ResourceManifest::findPath(const std::string& path) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = byPath.find(path);
+        if (it != byPath.end()) return it->second;
+    }
+    if (!rescanAfterMiss()) return std::nullopt;
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto it = byPath.find(path);
+    if (it != byPath.end()) return it->second;
+    return std::nullopt;
+}
+
+bool ResourceManifest::exists(const std::string& path) {
+    return findPath(path).has_value();
+}
+
+bool ResourceManifest::isIndexed(const std::string& path) {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return byPath.find(path) != byPath.end();
+}
+
+SDL_RWops* ResourceManifest::open(const ResourceEntry& entry) {
+    if (entry.data) {
+        return SDL_RWFromConstMem(entry.data, static_cast<int>(entry.size));
+    }
+    return SDL_RWFromFile(entry.path.c_str(), "rb");
+}
+
+size_t ResourceManifest::size() {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return byPath.size();
+}
+
+std::optional<uint64_t> ResourceManifest::findContentHash(const ResourceEntry& entry) {
+    std::lock_guard<std::mutex> lock(hashMutex);
+    auto it = hashes.find(entry.path);
+    // a file edited or a pack mounted since it was hashed has to be read again
+    if (it == hashes.end() || it->second.size != entry.size || it->second.modified != entry.modified || it->second.data != entry.data) {
+        return std::nullopt;
+    }
+    return it->second.hash;
+}
+
+uint64_t ResourceManifest::contentHash(const ResourceEntry& entry) {
+    std::optional<uint64_t> cached = findContentHash(entry);
+    if (cached.has_value()) return *cached;
+
+    uint64_t hash = 14695981039346656037ULL;
+    if (entry.data) {
+        hashBytes(hash, reinterpret_cast<const unsigned char*>(entry.data), static_cast<size_t>(entry.size));
+    }
+    else {
+        SDL_RWops* file = SDL_RWFromFile(entry.path.c_str(), "rb");
+        if (!file) return 0;
+        unsigned char buffer[16384];
+        size_t count = 0;
+        while ((count = SDL_RWread(file, buffer, 1, sizeof(buffer))) > 0) {
+            hashBytes(hash, buffer, count);
+        }
+        SDL_RWclose(file);
+    }
+    return cacheHash(entry, hash);
+}
+
+uint64_t ResourceManifest::contentHash(const ResourceEntry& entry, const char* bytes, size_t size) {
+    std::optional<uint64_t> cached = findContentHash(entry);
+    if (cached.has_value()) return *cached;
+    uint64_t hash = 14695981039346656037ULL;
+    hashBytes(hash, reinterpret_cast<const unsigned char*>(bytes), size);
+    return cacheHash(entry, hash);
+}
+
+void ResourceManifest::hashBytes(uint64_t& hash, const unsigned char* bytes, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
+uint64_t ResourceManifest::cacheHash(const ResourceEntry& entry, uint64_t hash) {
+    CachedHash cachedHash;
+    cachedHash.size = entry.size;
+    cachedHash.modified = entry.modified;
+    cachedHash.data = entry.data;
+    cachedHash.hash = hash;
+    std::lock_guard<std::mutex> lock(hashMutex);
+    hashes[entry.path] = cachedHash;
+    return hash;
+}
@@ -0,0 +1,101 @@
+//
+//  ResourceManifest.hpp
+//  game_engine
+//
+
+#ifndef ResourceManifest_hpp
+#define ResourceManifest_hpp
+
+#include <stdio.h>
+#include <string>
+#include <optional>
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <cstdint>
+#include <filesystem>
+#ifdef __APPLE__
+    #include "SDL2/SDL.h"
+#else
+    #include "SDL.h"
+#endif
+#include "PackArchive.hpp"
+
+enum class ResourceType {
+    Image,
+    Audio,
+    Scene,
+    Template,
+    Font,
+    Config,
+    Other
+};
+
+#define RESOURCE_TYPE_COUNT 7
+
+struct ResourceEntry {
+    std::string path;
+    ResourceType type = ResourceType::Other;
+    uintmax_t size = 0;
+    const char* data = nullptr; // set when the file lives in the mounted pack
+    std::filesystem::file_time_type modified{}; // loose files only
+};
+
+// every file under resources/, found with one directory walk instead of probing the disk per lookup
+// logical names are the path inside the type's directory without the extension, so
+// resources/images/ui/button.png is the Image "ui/button" and resources/audio/hit.wav the Audio "hit"
+// files directly in resources/ are Config entries named by their file name ("game.config")
+// a mounted resources.pak is indexed first, loose files under resources/ override what it holds
+// safe to read from several threads, scan and rescan take the index exclusively
+class ResourceManifest {
+public:
+    static void scan(const std::string& root = "resources");
+    static void rescan();
+    // when on, a lookup that misses rescans once before giving up, for editing content while the game runs
+    static void setRescanOnMiss(bool enabled);
+    // maps the pack and reindexes, false if it's missing or invalid
+    static bool mountPack(const std::string& path);
+    static bool isPackMounted();
+    static std::optional<ResourceEntry> find(ResourceType type, const std::string& name);
+    static bool contains(ResourceType type, const std::string& name);
+    // by file path as the loaders build it, e.g. "resources/scenes/basement.scene"
+    static std::optional<ResourceEntry> findPath(const std::string& path);
+    static bool exists(const std::string& path);
+    // exists without the rescan on a miss, for probing paths that are usually missing
+    static bool isIndexed(const std::string& path);
+    static size_t size();
+    // the type and logical name a file path would be indexed under
+    static void identify(const std::string& path, ResourceType& type, std::string& name);
+    // reads the entry from the pack mapping or the file, the caller frees it (or passes freesrc 1)
+    static SDL_RWops* open(const ResourceEntry& entry);
+    // 64 bit FNV-1a of the file's bytes, read once and kept until the file changes, 0 if it can't be read
+    static uint64_t contentHash(const ResourceEntry& entry);
+    // the same hash for bytes the caller already read from the entry, so they aren't read twice
+    static uint64_t contentHash(const ResourceEntry& entry, const char* bytes, size_t size);
+    // only what has been hashed already, never touches the disk
+    static std::optional<uint64_t> findContentHash(const ResourceEntry& entry);
+private:
+    struct CachedHash {
+        uintmax_t size = 0;
+        std::filesystem::file_time_type modified{};
+        const char* data = nullptr;
+        uint64_t hash = 0;
+    };
+    static void scanLocked();
+    static void addEntry(const ResourceEntry& entry);
+    static void classify(const std::string& relativePath, ResourceType& type, std::string& name);
+    static bool rescanAfterMiss();
+    static void hashBytes(uint64_t& hash, const unsigned char* bytes, size_t count);
+    static uint64_t cacheHash(const ResourceEntry& entry, uint64_t hash);
+
+    static std::shared_mutex mutex;
+    static std::string root;
+    static std::unordered_map<std::string, ResourceEntry> index[RESOURCE_TYPE_COUNT];
+    static std::unordered_map<std::string, ResourceEntry> byPath;
+    static bool rescanOnMiss;
+    static PackArchive pack;
+    static std::mutex hashMutex;
+    static std::unordered_map<std::string, CachedHash> hashes; // by path
+};
+
+#endif /* ResourceManifest_hpp */
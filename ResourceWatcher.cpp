@@ -0,0 +1,96 @@
+//
+//  ResourceWatcher.cpp
+//  game_engine
+//
+
+#include "ResourceWatcher.hpp"
+#include <iostream>
+#include <filesystem>
+#include <unordered_set>
+#ifdef __linux__
+    #include <sys/inotify.h>
+    #include <unistd.h>
+    #include <fcntl.h>
+#endif
+
+ResourceWatcher::~ResourceWatcher() {
+    stop();
+}
+
+bool ResourceWatcher::start(const std::string& root) {
+#ifdef __linux__
+    stop();
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "error: hot reload couldn't start watching " << root << std::endl;
+        return false;
+    }
+    watchDirectory(root);
+    return true;
+#else
+    std::cout << "hot reload needs inotify, resources won't be watched on this platform" << std::endl;
+    return false;
+#endif
+}
+
+void ResourceWatcher::watchDirectory(const std::string& path) {
+#ifdef __linux__
+    // editors either rewrite a file (close after write) or write a copy and rename it over the original
+    int watch = inotify_add_watch(fd, path.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (watch < 0) return;
+    watchedDirectories[watch] = std::filesystem::path(path).generic_string();
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(path, error)) {
+        std::error_code entryError;
+        if (entry.is_directory(entryError)) {
+            watchDirectory(entry.path().string());
+        }
+    }
+#endif
+}
+
+void ResourceWatcher::stop() {
+#ifdef __linux__
+    if (fd >= 0) {
+        close(fd);
+    }
+#endif
+    fd = -1;
+    watchedDirectories.clear();
+}
+
+bool ResourceWatcher::isRunning() const {
+    return fd >= 0;
+}
+
+std::vector<std::string> ResourceWatcher::poll() {
+    std::vector<std::string> changed;
+#ifdef __linux__
+    if (fd < 0) return changed;
+    std::unordered_set<std::string> seen;
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        ssize_t length = read(fd, buffer, sizeof(buffer));
+        if (length <= 0) break; // EAGAIN, nothing more this frame
+        for (char* cursor = buffer; cursor < buffer + length;) {
+            inotify_event* event = reinterpret_cast<inotify_event*>(cursor);
+            cursor += sizeof(inotify_event) + event->len;
+            auto directory = watchedDirectories.find(event->wd);
+            if (directory == watchedDirectories.end() || event->len == 0) continue;
+            std::string path = directory->second + "/" + event->name;
+            if (event->mask & IN_ISDIR) {
+                // new folders get watched too, files copied into them show up as they're written
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    watchDirectory(path);
+                }
+                continue;
+            }
+            // a bare create is followed by a close once the file is written
+            if ((event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) && seen.insert(path).second) {
+                changed.push_back(path);
+            }
+        }
+    }
+#endif
+    return changed;
+}
@@ -0,0 +1,31 @@
+//
+//  ResourceWatcher.hpp
+//  game_engine
+//
+
+#ifndef ResourceWatcher_hpp
+#define ResourceWatcher_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// dev mode watcher on resources/ (and every directory under it) through inotify
+// poll() is called once a frame and never blocks, other platforms don't get hot reload
+class ResourceWatcher {
+public:
+    ~ResourceWatcher();
+    bool start(const std::string& root);
+    void stop();
+    bool isRunning() const;
+    // files finished writing (or renamed into place) since the last poll, each once
+    // paths are '/' separated like the manifest's, e.g. "resources/images/hero.png"
+    std::vector<std::string> poll();
+private:
+    void watchDirectory(const std::string& path);
+    int fd = -1;
+    std::unordered_map<int, std::string> watchedDirectories;
+};
+
+#endif /* ResourceWatcher_hpp */
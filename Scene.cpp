@@ -45,6 +45,7 @@ bool Scene::attemptMove(Actor* actor, const glm::vec2& newPosition) {
             // if collision occurs, add to collidingActorsThisFrame vec of both actors
             actor->addActorToColliding(other);
             other->addActorToColliding(actor);
+            contactPairs.push_back(std::pair(actor, other));
             this->contactDialogues.push_back(std::pair(other->getContactDialogue(), other));
         }
     }
@@ -65,6 +66,7 @@ bool Scene::attemptMove(Actor* actor, const glm::vec2& newPosition) {
 
 void Scene::updateActors(double playerSpeed, Audio& audio, std::string stepAudio){
     //int currFrame = Helper::GetFrameNumber();
+    contactPairs.clear();
     for (Actor* actor : movingActors) {
         if (actor->getActorName() == "player"){
             handlePlayerMovement(actor, playerSpeed, audio, stepAudio);
@@ -80,6 +82,7 @@ void Scene::updateActors(double playerSpeed, Audio& audio, std::string stepAudio
     for (Actor* actor : collisionActors){
         actor->cleanCollisionsThisFrame();
     }
+    particles.update();
 }
 
 void Scene::addMovingActor(Actor* actor) {
@@ -89,47 +92,101 @@ void Scene::addMovingActor(Actor* actor) {
 
 void Scene::renderActors(Renderer& renderer, Camera& camera) {
     double zoomFactor = camera.getZoomFactor();
-    SDL_RenderSetScale(renderer.getRendererSDL(), zoomFactor, zoomFactor);
+    renderer.SetScale(zoomFactor, zoomFactor);
+    // baked scenery goes underneath everything else
+    renderer.RenderStaticLayer(camera.getPosition(), zoomFactor);
+    // particle pools are in layer order, each one goes in before the first actor drawn above its layer
+    const std::vector<ParticlePool>& pools = particles.getPools();
+    size_t nextPool = 0;
+    const std::vector<Actor*>& sortedRenderActors = renderQueue.getActors();
     for (int i = 0; i < sortedRenderActors.size(); ++i){
         Actor* actor = sortedRenderActors[i];
         if (actor) {
+            int order = actor->getRenderOrder().value_or(static_cast<int>(actor->getPosition().y));
+            while (nextPool < pools.size() && pools[nextPool].layer <= order) {
+                renderer.RenderParticles(pools[nextPool++], camera.getPosition(), zoomFactor);
+            }
             renderer.RenderActor(*actor, camera.getPosition(), zoomFactor);
         }
     }
-//    for (int i = 0; i < collisionActors.size(); ++i){
-//        Actor* actor = collisionActors[i];
-//        renderer.RenderCollider(*actor, camera.getPosition(), actor->getCollider(ColliderType::Collision));
-//    }
-//    for (int i = 0; i < triggerActors.size(); ++i){
-//        Actor* actor = triggerActors[i];
-//        renderer.RenderCollider(*actor, camera.getPosition(), actor->getCollider(ColliderType::Trigger));
-//    }
+    while (nextPool < pools.size()) {
+        renderer.RenderParticles(pools[nextPool++], camera.getPosition(), zoomFactor);
+    }
+    if (renderer.getDebugOverlay()) {
+        renderDebugOverlay(renderer, camera);
+    }
+}
+
+void Scene::renderDebugOverlay(Renderer& renderer, Camera& camera) {
+    // one batch per color: chunk cells, trigger boxes, collision boxes, then this frame's contacts on top
+    double zoomFactor = camera.getZoomFactor();
+    debugRects.clear();
+    renderer.getStaticLayerCells(debugRects);
+    renderer.RenderDebugRects(debugRects, {0, 128, 255, 255}, false, camera.getPosition(), zoomFactor);
+
+    debugRects.clear();
+    for (Actor* actor : triggerActors) {
+        const Collider& collider = actor->getCollider(ColliderType::Trigger);
+        debugRects.push_back({collider.left, collider.top, collider.width, collider.height});
+    }
+    renderer.RenderDebugRects(debugRects, {0, 255, 0, 255}, false, camera.getPosition(), zoomFactor);
+
+    debugRects.clear();
+    for (Actor* actor : collisionActors) {
+        const Collider& collider = actor->getCollider(ColliderType::Collision);
+        debugRects.push_back({collider.left, collider.top, collider.width, collider.height});
+    }
+    renderer.RenderDebugRects(debugRects, {255, 0, 0, 255}, false, camera.getPosition(), zoomFactor);
+
+    // contacts are drawn as the overlap of the two boxes
+    debugRects.clear();
+    for (const std::pair<Actor*, Actor*>& contact : contactPairs) {
+        const Collider& a = contact.first->getCollider(ColliderType::Collision);
+        const Collider& b = contact.second->getCollider(ColliderType::Collision);
+        float left = std::max(a.left, b.left);
+        float top = std::max(a.top, b.top);
+        debugRects.push_back({left, top, std::min(a.right, b.right) - left, std::min(a.bottom, b.bottom) - top});
+    }
+    renderer.RenderDebugRects(debugRects, {255, 255, 0, 160}, true, camera.getPosition(), zoomFactor);
 }
 
 void Scene::sortActorsByRenderOrder() {
-    sortedRenderActors.clear();
+    renderQueue.clear();
     
-    // populate sortedRenderActors w/ pointers to the actors
+    // populate the queue w/ pointers to the actors (baked ones are drawn by the static layer)
+    // actors are stored in actorID order, which the radix sort relies on for ties
+    for (Actor& actor : actors) {
+        if (!actor.isStaticBaked()) {
+            renderQueue.push(&actor);
+        }
+    }
+    if (worldStreamer) {
+        worldStreamer->pushActors(renderQueue);
+    }
+    renderQueue.sort();
+}
+
+void Scene::bakeStaticLayer(Renderer& renderer) {
+    std::optional<int> threshold = renderer.getStaticLayerThreshold();
+    if (!threshold.has_value()) return;
+
+    std::vector<Actor*> staticActors;
     for (Actor& actor : actors) {
-        sortedRenderActors.push_back(&actor);
+        // anything that can move or swap its image has to stay dynamic
+        if (&actor == player) continue;
+        if (actor.getVelocity().x != 0 || actor.getVelocity().y != 0) continue;
+        if (!actor.getRenderOrder().has_value() || actor.getRenderOrder().value() >= threshold.value()) continue;
+        if (!actor.getViewImage() || actor.hasReactionImages() || actor.isAnimated()) continue;
+        staticActors.push_back(&actor);
     }
-    std::sort(sortedRenderActors.begin(), sortedRenderActors.end(), [](const Actor* a, const Actor* b) {
-        // Compare using render_order if available; else use transform_position_y
-        int aOrder = a->getRenderOrder().value_or(static_cast<int>(a->getPosition().y));
-        int bOrder = b->getRenderOrder().value_or(static_cast<int>(b->getPosition().y));
+    if (staticActors.empty()) return;
 
-        if (aOrder != bOrder) {
-            return aOrder < bOrder;
-        }
-        // if render_order is the same, use y position
-        else if (a->getPosition().y != b->getPosition().y) {
-            return a->getPosition().y < b->getPosition().y;
+    std::sort(staticActors.begin(), staticActors.end(), RenderQueue::renderOrderLess);
+    if (renderer.BakeStaticLayer(staticActors)) {
+        for (Actor* actor : staticActors) {
+            actor->setStaticBaked(true);
         }
-        // if both render_order and y pos are the same, break tie with actorID
-        else {
-            return a->getActorID() < b->getActorID();
-        }
-    });
+    }
 }
 
 void Scene::handlePlayerMovement(Actor* player, double playerSpeed, Audio& audio, std::string stepAudio){
@@ -157,8 +214,7 @@ void Scene::handlePlayerMovement(Actor* player, double playerSpeed, Audio& audio
         movement = glm::normalize(movement);
         // when moving, play sound effect (if it exists) every 20th frame
         if (stepAudio != "" && Helper::GetFrameNumber() % 20 == 0){
-            int channel_num = Helper::GetFrameNumber() % 48 + 2;
-            audio.playMusic(stepAudio, channel_num, 0);
+            audio.playSound(stepAudio);
         }
     }
     
@@ -196,3 +252,78 @@ void Scene::collectTriggerText(){
         }
     }
 }
+
+void Scene::addTemplateName(const std::string& templateName){
+    templateNames.insert(templateName);
+}
+
+ParticleSystem& Scene::getParticles() {
+    return particles;
+}
+
+std::vector<ActorRecord>& Scene::getActorRecords() {
+    return actorRecords;
+}
+
+std::vector<uint64_t>& Scene::getActorSourceHashes() {
+    return actorSourceHashes;
+}
+
+void Scene::clearActorLists() {
+    player = nullptr;
+    renderQueue.clear();
+    movingActors.clear();
+    collisionActors.clear();
+    triggerActors.clear();
+    contactDialogues.clear();
+    nearbyDialogues.clear();
+    contactPairs.clear();
+    particles.clear();
+    for (Actor& actor : actors) {
+        actor.cleanCollisionsThisFrame();
+    }
+}
+
+void Scene::rebakeStaticLayer(Renderer& renderer) {
+    for (Actor& actor : actors) {
+        actor.setStaticBaked(false);
+    }
+    renderer.ClearStaticLayer();
+    bakeStaticLayer(renderer);
+}
+
+void Scene::removeActors(const std::unordered_set<const Actor*>& removed) {
+    auto isRemoved = [&removed](const Actor* actor) {
+        return removed.count(actor) > 0;
+    };
+    auto isRemovedDialogue = [&isRemoved](const std::pair<std::string, Actor*>& dialogue) {
+        return isRemoved(dialogue.second);
+    };
+    // rebuilt by the next sort
+    renderQueue.clear();
+    movingActors.erase(std::remove_if(movingActors.begin(), movingActors.end(), isRemoved), movingActors.end());
+    collisionActors.erase(std::remove_if(collisionActors.begin(), collisionActors.end(), isRemoved), collisionActors.end());
+    triggerActors.erase(std::remove_if(triggerActors.begin(), triggerActors.end(), isRemoved), triggerActors.end());
+    contactDialogues.erase(std::remove_if(contactDialogues.begin(), contactDialogues.end(), isRemovedDialogue), contactDialogues.end());
+    nearbyDialogues.erase(std::remove_if(nearbyDialogues.begin(), nearbyDialogues.end(), isRemovedDialogue), nearbyDialogues.end());
+    contactPairs.erase(std::remove_if(contactPairs.begin(), contactPairs.end(), [&isRemoved](const std::pair<Actor*, Actor*>& contact) {
+        return isRemoved(contact.first) || isRemoved(contact.second);
+    }), contactPairs.end());
+    // particles already in flight stay, only the emitters go
+    particles.removeEmitters(removed);
+    for (Actor* actor : collisionActors) {
+        actor->cleanCollisionsThisFrame();
+    }
+}
+
+WorldStreamer* Scene::getWorldStreamer() {
+    return worldStreamer.get();
+}
+
+void Scene::setWorldStreamer(std::unique_ptr<WorldStreamer> streamer) {
+    worldStreamer = std::move(streamer);
+}
+
+const std::unordered_set<std::string>& Scene::getTemplateNames() const {
+    return templateNames;
+}
@@ -13,15 +13,31 @@
 #include <optional>
 #include <vector>
 #include <utility>
+#include <memory>
 #include "Utility.hpp"
 #include "Actor.hpp"
 #include "glm/glm.hpp"
 #include "Renderer.hpp"
 #include "Camera.hpp"
 #include "Audio.hpp"
+#include "ParticleSystem.hpp"
+#include "RenderQueue.hpp"
+#include "WorldStreamer.hpp"
 #define SCENE_UNIT 100
 
 class Engine;
+
+// what an actor needs registered with the scene once it has its final address
+struct ActorRecord {
+    bool isMoving = false;
+    bool hasCollider = false;
+    bool hasTrigger = false;
+    bool isPlayer = false;
+    std::string damageSFX;
+    std::string stepSFX;
+    std::vector<EmitterConfig> particleEmitters;
+};
+
 class Scene {
 public:
     Scene(const std::string& sceneFilePath);
@@ -38,7 +54,9 @@ public:
     void updateLocationToActors(glm::vec2& pos, Actor& actor);
     
     void renderActors(Renderer& renderer, Camera& camera);
+    void renderDebugOverlay(Renderer& renderer, Camera& camera);
     void sortActorsByRenderOrder();
+    void bakeStaticLayer(Renderer& renderer);
     void handlePlayerMovement(Actor* player, double playerSpeed, Audio& audio, std::string stepAudio);
     
     void addCollisionActor(Actor* actor);
@@ -47,16 +65,38 @@ public:
     const std::vector<std::pair<std::string, Actor*>>& getNearbyDialogues();
     void clearDialogues();
     void collectTriggerText();
+    void addTemplateName(const std::string& templateName);
+    const std::unordered_set<std::string>& getTemplateNames() const;
+    ParticleSystem& getParticles();
+    // kept only with hot reload on, one per actor in file order, so an edited scene can be diffed
+    std::vector<ActorRecord>& getActorRecords();
+    std::vector<uint64_t>& getActorSourceHashes();
+    // drops every list that points into actors, before they are replaced
+    void clearActorLists();
+    void rebakeStaticLayer(Renderer& renderer);
+    // takes actors out of every list, for chunks that stream out
+    void removeActors(const std::unordered_set<const Actor*>& removed);
+    // nullptr unless the scene has world_chunks
+    WorldStreamer* getWorldStreamer();
+    void setWorldStreamer(std::unique_ptr<WorldStreamer> streamer);
 private:
     std::vector<Actor> actors;
     Actor* player = nullptr;
     std::string sceneFilePath = "";
-    std::vector<Actor*> sortedRenderActors;
+    RenderQueue renderQueue;
     std::vector<Actor*> movingActors;
     std::vector<Actor*> collisionActors;
     std::vector<Actor*> triggerActors;
     std::vector<std::pair<std::string, Actor*>> contactDialogues;
     std::vector<std::pair<std::string, Actor*>> nearbyDialogues;
+    std::unordered_set<std::string> templateNames;
+    ParticleSystem particles;
+    std::vector<std::pair<Actor*, Actor*>> contactPairs; // collisions found this frame
+    std::vector<SDL_FRect> debugRects;
+    std::vector<ActorRecord> actorRecords;
+    std::vector<uint64_t> actorSourceHashes;
+    // last, so chunk actors go before the lists that point at them
+    std::unique_ptr<WorldStreamer> worldStreamer;
 };
 
 #endif /* Scene_hpp */
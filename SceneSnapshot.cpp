@@ -0,0 +1,76 @@
+//
+//  SceneSnapshot.cpp
+//  game_engine
+//
+
+#include "SceneSnapshot.hpp"
+#include <cstring>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<ActorState>::value, "actor states are copied into snapshots as bytes");
+static_assert(std::is_trivially_copyable<SessionState>::value, "session state is copied into snapshots as bytes");
+
+size_t SceneSnapshot::statesOffset(uint32_t scenePathLength) {
+    // the states start aligned so they can be copied straight out
+    size_t offset = sizeof(Header) + scenePathLength;
+    size_t alignment = alignof(ActorState);
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+SceneSnapshot SceneSnapshot::capture(const std::string& scenePath, const SessionState& session, const std::vector<Actor>& actors, int currentFrame) {
+    SceneSnapshot snapshot;
+    Header header;
+    header.actorCount = static_cast<uint32_t>(actors.size());
+    header.scenePathLength = static_cast<uint32_t>(scenePath.size());
+    header.session = session;
+
+    size_t offset = statesOffset(header.scenePathLength);
+    snapshot.blob.assign(offset + actors.size() * sizeof(ActorState), 0);
+    char* data = snapshot.blob.data();
+    std::memcpy(data, &header, sizeof(header));
+    std::memcpy(data + sizeof(header), scenePath.data(), scenePath.size());
+    for (const Actor& actor : actors) {
+        ActorState state = actor.saveState(currentFrame);
+        std::memcpy(data + offset, &state, sizeof(state));
+        offset += sizeof(state);
+    }
+    return snapshot;
+}
+
+bool SceneSnapshot::readHeader(Header& header) const {
+    if (blob.size() < sizeof(header)) return false;
+    std::memcpy(&header, blob.data(), sizeof(header));
+    if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION) return false;
+    return blob.size() == statesOffset(header.scenePathLength) + header.actorCount * sizeof(ActorState);
+}
+
+bool SceneSnapshot::restore(SessionState& session, std::vector<Actor>& actors, int currentFrame) const {
+    Header header;
+    if (!readHeader(header) || header.actorCount != actors.size()) return false;
+    std::vector<ActorState> states(header.actorCount);
+    std::memcpy(states.data(), blob.data() + statesOffset(header.scenePathLength), states.size() * sizeof(ActorState));
+    // checked before anything is written, a scene edited since the snapshot is left as it is
+    // ids are compared from the first actor on, a scene loaded again hands out new ones in the same order
+    for (size_t i = 0; i < states.size(); ++i) {
+        if (states[i].actorID - states[0].actorID != actors[i].getActorID() - actors[0].getActorID()) return false;
+    }
+    for (size_t i = 0; i < states.size(); ++i) {
+        actors[i].restoreState(states[i], currentFrame);
+    }
+    session = header.session;
+    return true;
+}
+
+bool SceneSnapshot::isEmpty() const {
+    return blob.empty();
+}
+
+std::string SceneSnapshot::getScenePath() const {
+    Header header;
+    if (!readHeader(header)) return "";
+    return std::string(blob.data() + sizeof(header), header.scenePathLength);
+}
+
+size_t SceneSnapshot::getSize() const {
+    return blob.size();
+}
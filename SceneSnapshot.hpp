@@ -0,0 +1,51 @@
+//
+//  SceneSnapshot.hpp
+//  game_engine
+//
+
+#ifndef SceneSnapshot_hpp
+#define SceneSnapshot_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "glm/glm.hpp"
+#include "Actor.hpp"
+
+#define SNAPSHOT_MAGIC 0x50414E53 // "SNAP"
+#define SNAPSHOT_VERSION 2
+
+// what the engine itself tracks about a run, next to the actors
+struct SessionState {
+    int health = 3;
+    int score = 0;
+    int framesSinceHealthDown = 181; // the damage cooldown, relative like the actors' frames
+    glm::vec2 cameraPosition = glm::vec2(0, 0);
+};
+
+// a scene's runtime state as one binary blob: a header, the scene's path, then an ActorState per actor
+// in the scene's actor order. restoring copies the states back over the live actors,
+// nothing is parsed or rebuilt, so it only works on the same scene with the same actors
+class SceneSnapshot {
+public:
+    static SceneSnapshot capture(const std::string& scenePath, const SessionState& session, const std::vector<Actor>& actors, int currentFrame);
+    // false (and nothing touched) if the blob doesn't match these actors
+    bool restore(SessionState& session, std::vector<Actor>& actors, int currentFrame) const;
+    bool isEmpty() const;
+    std::string getScenePath() const;
+    size_t getSize() const;
+private:
+    struct Header {
+        uint32_t magic = SNAPSHOT_MAGIC;
+        uint32_t version = SNAPSHOT_VERSION;
+        uint32_t actorCount = 0;
+        uint32_t scenePathLength = 0;
+        SessionState session;
+    };
+    static size_t statesOffset(uint32_t scenePathLength);
+    bool readHeader(Header& header) const;
+    std::vector<char> blob;
+};
+
+#endif /* SceneSnapshot_hpp */
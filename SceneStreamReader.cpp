@@ -0,0 +1,147 @@
+//
+//  SceneStreamReader.cpp
+//  game_engine
+//
+
+#include "SceneStreamReader.hpp"
+#include <cstring>
+#include "rapidjson/stream.h"
+
+// scratch for one actor's json, only actors with very long dialogue spill past it
+#define ACTOR_BUFFER_SIZE (64 * 1024)
+
+SceneStreamReader::SceneStreamReader(const std::string& path, bool exitOnError)
+    : file(path, false, exitOnError), actorBuffer(ACTOR_BUFFER_SIZE), actorAllocator(actorBuffer.data(), actorBuffer.size())
+{
+}
+
+bool SceneStreamReader::read(std::function<void(size_t)> onCountHint_in, std::function<void(const rapidjson::Value&)> onActor_in) {
+    onCountHint = onCountHint_in;
+    onActor = onActor_in;
+    if (!file.isValid()) return false;
+    Handler handler(*this);
+    rapidjson::Reader reader;
+    // not in place, strings are copied out so the mapped pages stay clean and can be dropped
+    rapidjson::StringStream stream(file.getText());
+    reader.Parse(stream, handler);
+    return !reader.HasParseError() && sceneValues.IsObject();
+}
+
+const rapidjson::Value& SceneStreamReader::getSceneValues() const {
+    return sceneValues;
+}
+
+rapidjson::MemoryPoolAllocator<>& SceneStreamReader::Handler::allocator() {
+    return inActors ? reader.actorAllocator : reader.sceneAllocator;
+}
+
+bool SceneStreamReader::Handler::isTopLevelKey(const char* name) const {
+    // the scene object and one key above it
+    return stack.size() == 2 && stack.back().IsString() && std::strcmp(stack.back().GetString(), name) == 0;
+}
+
+bool SceneStreamReader::Handler::finish(rapidjson::Value& value) {
+    if (stack.empty()) {
+        // the scene itself
+        if (!value.IsObject()) return false;
+        reader.sceneValues = value;
+        return true;
+    }
+    if (stack.back().IsArray()) {
+        stack.back().PushBack(value, allocator());
+        return true;
+    }
+    // an element of actors, build it and forget it
+    if (inActors && stack.size() == 2) {
+        reader.onActor(value);
+        value.SetNull();
+        reader.actorAllocator.Clear();
+        return true;
+    }
+    if (isTopLevelKey("actor_count") && value.IsUint() && reader.onCountHint) {
+        reader.onCountHint(value.GetUint());
+    }
+    rapidjson::Value key(std::move(stack.back()));
+    stack.pop_back();
+    stack.back().AddMember(key, value, allocator());
+    return true;
+}
+
+bool SceneStreamReader::Handler::Null() {
+    rapidjson::Value value;
+    return finish(value);
+}
+
+bool SceneStreamReader::Handler::Bool(bool b) {
+    rapidjson::Value value(b);
+    return finish(value);
+}
+
+bool SceneStreamReader::Handler::Int(int i) {
+    rapidjson::Value value(i);
+    return finish(value);
+}
+
+bool SceneStreamReader::Handler::Uint(unsigned u) {
+    rapidjson::Value value(u);
+    return finish(value);
+}
+
+bool SceneStreamReader::Handler::Int64(int64_t i) {
+    rapidjson::Value value(i);
+    return finish(value);
+}
+
+bool SceneStreamReader::Handler::Uint64(uint64_t u) {
+    rapidjson::Value value(u);
+    return finish(value);
+}
+
+bool SceneStreamReader::Handler::Double(double d) {
+    rapidjson::Value value(d);
+    return finish(value);
+}
+
+bool SceneStreamReader::Handler::String(const char* str, rapidjson::SizeType length, bool /*copy*/) {
+    rapidjson::Value value(str, length, allocator());
+    return finish(value);
+}
+
+bool SceneStreamReader::Handler::StartObject() {
+    stack.emplace_back(rapidjson::kObjectType);
+    return true;
+}
+
+bool SceneStreamReader::Handler::Key(const char* str, rapidjson::SizeType length, bool /*copy*/) {
+    stack.emplace_back(str, length, allocator());
+    return true;
+}
+
+bool SceneStreamReader::Handler::EndObject(rapidjson::SizeType /*memberCount*/) {
+    rapidjson::Value value(std::move(stack.back()));
+    stack.pop_back();
+    return finish(value);
+}
+
+bool SceneStreamReader::Handler::StartArray() {
+    // a scene has to be an object
+    if (stack.empty()) return false;
+    if (!inActors && isTopLevelKey("actors")) {
+        // the actors array itself is never built, only its elements
+        inActors = true;
+        return true;
+    }
+    stack.emplace_back(rapidjson::kArrayType);
+    return true;
+}
+
+bool SceneStreamReader::Handler::EndArray(rapidjson::SizeType /*elementCount*/) {
+    if (inActors && stack.size() == 2) {
+        inActors = false;
+        stack.pop_back(); // the "actors" key
+        return true;
+    }
+    rapidjson::Value value(std::move(stack.back()));
+    stack.pop_back();
+    return finish(value);
+}
@@ -0,0 +1,66 @@
+//
+//  SceneStreamReader.hpp
+//  game_engine
+//
+
+#ifndef SceneStreamReader_hpp
+#define SceneStreamReader_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <functional>
+#include "rapidjson/document.h"
+#include "rapidjson/reader.h"
+#include "JsonFile.hpp"
+
+// reads a scene file as a stream of parse events instead of one big DOM
+// each element of "actors" is handed out as soon as it closes and then thrown away,
+// so memory stays at one actor's json on top of whatever the callback builds from it
+// "actor_count", if it comes before "actors", is passed on so storage can be reserved once
+class SceneStreamReader {
+public:
+    // exitOnError as for JsonFile, a file that can't be read then fails read()
+    explicit SceneStreamReader(const std::string& path, bool exitOnError = true);
+    // returns false on a parse error or if the scene isn't an object
+    bool read(std::function<void(size_t)> onCountHint, std::function<void(const rapidjson::Value&)> onActor);
+    // every top level member except "actors", valid after read
+    const rapidjson::Value& getSceneValues() const;
+private:
+    struct Handler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, Handler> {
+        explicit Handler(SceneStreamReader& reader_in) : reader(reader_in) {}
+        bool Null();
+        bool Bool(bool b);
+        bool Int(int i);
+        bool Uint(unsigned u);
+        bool Int64(int64_t i);
+        bool Uint64(uint64_t u);
+        bool Double(double d);
+        bool String(const char* str, rapidjson::SizeType length, bool copy);
+        bool StartObject();
+        bool Key(const char* str, rapidjson::SizeType length, bool copy);
+        bool EndObject(rapidjson::SizeType memberCount);
+        bool StartArray();
+        bool EndArray(rapidjson::SizeType elementCount);
+
+        bool finish(rapidjson::Value& value);
+        bool isTopLevelKey(const char* name) const;
+        rapidjson::MemoryPoolAllocator<>& allocator();
+
+        SceneStreamReader& reader;
+        // open objects and arrays, a string on top is the key of the value being read
+        std::vector<rapidjson::Value> stack;
+        bool inActors = false;
+    };
+
+    JsonFile file;
+    std::function<void(size_t)> onCountHint;
+    std::function<void(const rapidjson::Value&)> onActor;
+    // reused for every actor, cleared back to actorBuffer once the actor has been handed out
+    std::vector<char> actorBuffer;
+    rapidjson::MemoryPoolAllocator<> actorAllocator;
+    rapidjson::MemoryPoolAllocator<> sceneAllocator;
+    rapidjson::Value sceneValues;
+};
+
+#endif /* SceneStreamReader_hpp */
@@ -0,0 +1,79 @@
+//
+//  SoftwareBackend.cpp
+//  game_engine
+//
+
+#include "SoftwareBackend.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <filesystem>
+
+SoftwareBackend::~SoftwareBackend() {
+    if (surface) {
+        SDL_FreeSurface(surface);
+    }
+}
+
+SDL_Renderer* SoftwareBackend::Initialize(int width, int height) {
+    // fixed 32 bit format so hashes don't depend on the machine
+    surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA8888);
+    if (!surface) {
+        std::cerr << "Software render surface could not be created! SDL_Error: " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+    SDL_Renderer* renderer = SDL_CreateSoftwareRenderer(surface);
+    if (!renderer) {
+        std::cerr << "Software renderer could not be created! SDL_Error: " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+    hashLog.open(hashLogPath, std::ios::out | std::ios::trunc);
+    if (dumpDirectory != "") {
+        std::filesystem::create_directories(dumpDirectory);
+    }
+    return renderer;
+}
+
+void SoftwareBackend::setHashLogPath(const std::string& path) {
+    hashLogPath = path;
+}
+
+void SoftwareBackend::setDumpDirectory(const std::string& directory) {
+    dumpDirectory = directory;
+}
+
+void SoftwareBackend::captureFrame(int frameNumber, double rasterSeconds) {
+    lastHash = hashSurface(surface);
+    if (hashLog.is_open()) {
+        hashLog << frameNumber << " " << std::hex << std::setw(16) << std::setfill('0') << lastHash << std::dec
+                << " " << static_cast<int>(rasterSeconds * 1000000.0) << "us" << '\n';
+    }
+    if (dumpDirectory != "") {
+        std::ostringstream name;
+        name << dumpDirectory << "/frame_" << std::setw(6) << std::setfill('0') << frameNumber << ".png";
+        if (IMG_SavePNG(surface, name.str().c_str()) != 0) {
+            std::cerr << "Unable to save frame " << name.str() << ". SDL_image Error: " << IMG_GetError() << std::endl;
+        }
+    }
+}
+
+uint64_t SoftwareBackend::getLastHash() const {
+    return lastHash;
+}
+
+uint64_t SoftwareBackend::hashSurface(SDL_Surface* surface) {
+    // 64 bit FNV-1a over the visible bytes of each row (pitch padding is skipped)
+    uint64_t hash = 14695981039346656037ULL;
+    if (!surface) return hash;
+    SDL_LockSurface(surface);
+    const int rowBytes = surface->w * surface->format->BytesPerPixel;
+    for (int y = 0; y < surface->h; ++y) {
+        const Uint8* row = static_cast<const Uint8*>(surface->pixels) + y * surface->pitch;
+        for (int x = 0; x < rowBytes; ++x) {
+            hash ^= row[x];
+            hash *= 1099511628211ULL;
+        }
+    }
+    SDL_UnlockSurface(surface);
+    return hash;
+}
@@ -0,0 +1,41 @@
+//
+//  SoftwareBackend.hpp
+//  game_engine
+//
+
+#ifndef SoftwareBackend_hpp
+#define SoftwareBackend_hpp
+
+#include <stdio.h>
+#include <string>
+#include <fstream>
+#include <cstdint>
+#ifdef __APPLE__
+    #include "SDL2/SDL.h"
+    #include "SDL2_image/SDL_image.h"
+#else
+    #include "SDL.h"
+    #include "SDL_image.h"
+#endif
+
+// renders into a fixed size SDL_Surface with SDL's software renderer, no window or GPU needed
+// every frame gets a content hash (and optionally a png) so output can be compared pixel for pixel
+class SoftwareBackend {
+public:
+    ~SoftwareBackend();
+    SDL_Renderer* Initialize(int width, int height);
+    void setHashLogPath(const std::string& path);
+    void setDumpDirectory(const std::string& directory);
+    // call after the frame's commands are drawn and before it's presented
+    void captureFrame(int frameNumber, double rasterSeconds);
+    uint64_t getLastHash() const;
+    static uint64_t hashSurface(SDL_Surface* surface);
+private:
+    SDL_Surface* surface = nullptr;
+    std::string hashLogPath = "frame_hashes.log";
+    std::string dumpDirectory = "";
+    std::ofstream hashLog;
+    uint64_t lastHash = 0;
+};
+
+#endif /* SoftwareBackend_hpp */
@@ -0,0 +1,133 @@
+//
+//  StaticLayer.cpp
+//  game_engine
+//
+
+#include "StaticLayer.hpp"
+#include <cmath>
+#include <algorithm>
+#include "Utility.hpp"
+
+#define SCENE_UNIT 100
+
+StaticLayer::~StaticLayer() {
+    clear();
+}
+
+void StaticLayer::setChunkSize(int size) {
+    chunkSize = size;
+}
+
+bool StaticLayer::bake(SDL_Renderer* renderer, const std::vector<Actor*>& actors) {
+    if (!SDL_RenderTargetSupported(renderer)) {
+        return false;
+    }
+    // chunks are in unzoomed world pixels
+    SDL_RenderSetScale(renderer, 1.0, 1.0);
+    for (Actor* actor : actors) {
+        SDL_Texture* texture = actor->getViewImage();
+        if (!texture) continue;
+        int textureWidth, textureHeight;
+        SDL_QueryTexture(texture, nullptr, nullptr, &textureWidth, &textureHeight);
+        SDL_Point* pivotPoint = actor->getPivotSDLPoint();
+
+        // same placement as Renderer::RenderActor, just relative to the world origin instead of the camera
+        int worldX = static_cast<int>(std::round(actor->getPosition().x * SCENE_UNIT - pivotPoint->x));
+        int worldY = static_cast<int>(std::round(actor->getPosition().y * SCENE_UNIT - pivotPoint->y));
+        int w = static_cast<int>(textureWidth * std::abs(actor->getTransformScale().x));
+        int h = static_cast<int>(textureHeight * std::abs(actor->getTransformScale().y));
+
+        // rotated sprites can reach as far as their furthest corner from the pivot
+        int reach = 0;
+        if (actor->getTransformRotationDegrees() != 0.0) {
+            double dx = std::max(pivotPoint->x, w - pivotPoint->x);
+            double dy = std::max(pivotPoint->y, h - pivotPoint->y);
+            reach = static_cast<int>(std::ceil(std::sqrt(dx * dx + dy * dy)));
+        }
+        int left = std::min(worldX, worldX + pivotPoint->x - reach);
+        int top = std::min(worldY, worldY + pivotPoint->y - reach);
+        int right = std::max(worldX + w, worldX + pivotPoint->x + reach);
+        int bottom = std::max(worldY + h, worldY + pivotPoint->y + reach);
+
+        int firstChunkX = static_cast<int>(std::floor(static_cast<double>(left) / chunkSize));
+        int lastChunkX = static_cast<int>(std::floor(static_cast<double>(right - 1) / chunkSize));
+        int firstChunkY = static_cast<int>(std::floor(static_cast<double>(top) / chunkSize));
+        int lastChunkY = static_cast<int>(std::floor(static_cast<double>(bottom - 1) / chunkSize));
+
+        // draw into every chunk the sprite touches, each clips its own part
+        for (int chunkY = firstChunkY; chunkY <= lastChunkY; ++chunkY) {
+            for (int chunkX = firstChunkX; chunkX <= lastChunkX; ++chunkX) {
+                SDL_Texture* chunk = getOrCreateChunk(renderer, chunkX, chunkY);
+                if (!chunk) continue;
+                SDL_SetRenderTarget(renderer, chunk);
+                SDL_Rect dstRect = {worldX - chunkX * chunkSize, worldY - chunkY * chunkSize, w, h};
+                SDL_RenderCopyEx(renderer, texture, nullptr, &dstRect, actor->getTransformRotationDegrees(), pivotPoint, actor->getFlip());
+            }
+        }
+    }
+    SDL_SetRenderTarget(renderer, nullptr);
+    return true;
+}
+
+SDL_Texture* StaticLayer::getOrCreateChunk(SDL_Renderer* renderer, int chunkX, int chunkY) {
+    uint64_t key = create_composite_key(chunkX, chunkY);
+    auto it = chunks.find(key);
+    if (it != chunks.end()) {
+        return it->second;
+    }
+    SDL_Texture* chunk = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, chunkSize, chunkSize);
+    if (!chunk) {
+        std::cerr << "Unable to create static layer chunk. SDL Error: " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(chunk, SDL_BLENDMODE_BLEND);
+    // start fully transparent so the clear color shows through empty space
+    SDL_SetRenderTarget(renderer, chunk);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    chunks[key] = chunk;
+    return chunk;
+}
+
+void StaticLayer::render(RenderCommandList& list, glm::vec2 cameraPosition, double zoomFactor, int width, int height) const {
+    // visible area in world pixels
+    double halfViewWidth = (width * 0.5) / zoomFactor;
+    double halfViewHeight = (height * 0.5) / zoomFactor;
+    double cameraX = cameraPosition.x * SCENE_UNIT;
+    double cameraY = cameraPosition.y * SCENE_UNIT;
+    for (const auto& pair : chunks) {
+        int chunkX = static_cast<int>(static_cast<uint32_t>(pair.first >> 32));
+        int chunkY = static_cast<int>(static_cast<uint32_t>(pair.first));
+        double originX = static_cast<double>(chunkX) * chunkSize;
+        double originY = static_cast<double>(chunkY) * chunkSize;
+        if (originX + chunkSize < cameraX - halfViewWidth || originX > cameraX + halfViewWidth) continue;
+        if (originY + chunkSize < cameraY - halfViewHeight || originY > cameraY + halfViewHeight) continue;
+
+        SDL_Rect dstRect;
+        dstRect.x = static_cast<int>(std::round(originX - cameraX + halfViewWidth));
+        dstRect.y = static_cast<int>(std::round(originY - cameraY + halfViewHeight));
+        dstRect.w = chunkSize;
+        dstRect.h = chunkSize;
+        list.pushCopy(pair.second, dstRect);
+    }
+}
+
+void StaticLayer::clear() {
+    for (auto& pair : chunks) {
+        SDL_DestroyTexture(pair.second);
+    }
+    chunks.clear();
+}
+
+bool StaticLayer::empty() const {
+    return chunks.empty();
+}
+
+void StaticLayer::getChunkCells(std::vector<SDL_FRect>& cells) const {
+    float cellSize = static_cast<float>(chunkSize) / SCENE_UNIT;
+    for (const auto& pair : chunks) {
+        int chunkX = static_cast<int>(static_cast<uint32_t>(pair.first >> 32));
+        int chunkY = static_cast<int>(static_cast<uint32_t>(pair.first));
+        cells.push_back({chunkX * cellSize, chunkY * cellSize, cellSize, cellSize});
+    }
+}
@@ -0,0 +1,35 @@
+//
+//  StaticLayer.hpp
+//  game_engine
+//
+
+#ifndef StaticLayer_hpp
+#define StaticLayer_hpp
+
+#include <stdio.h>
+#include <vector>
+#include <unordered_map>
+#include "glm/glm.hpp"
+#include "Actor.hpp"
+#include "RenderCommandList.hpp"
+
+// static scenery baked once at scene load into world space chunk textures
+// each chunk covers chunkSize x chunkSize pixels of the unzoomed world
+class StaticLayer {
+public:
+    ~StaticLayer();
+    void setChunkSize(int size);
+    // actors must already be in render order, returns false if the renderer can't do render targets
+    bool bake(SDL_Renderer* renderer, const std::vector<Actor*>& actors);
+    void render(RenderCommandList& list, glm::vec2 cameraPosition, double zoomFactor, int width, int height) const;
+    void clear();
+    bool empty() const;
+    // chunk bounds in scene units, for the debug overlay
+    void getChunkCells(std::vector<SDL_FRect>& cells) const;
+private:
+    SDL_Texture* getOrCreateChunk(SDL_Renderer* renderer, int chunkX, int chunkY);
+    std::unordered_map<uint64_t, SDL_Texture*> chunks;
+    int chunkSize = 1024;
+};
+
+#endif /* StaticLayer_hpp */
@@ -6,9 +6,12 @@
 //
 
 #include "Template.hpp"
+#include <algorithm>
 
-Template::Template(const rapidjson::Document& doc, Renderer& renderer)
+Template::Template(const rapidjson::Document& doc, Renderer& renderer, const std::string& templateName)
 {
+    // template images stay resident for as long as the engine keeps the template around
+    std::string owner = textureOwner(templateName);
     if (doc.HasMember("name") && doc["name"].IsString()) {
         this->name = doc["name"].GetString();
     }
@@ -52,18 +55,18 @@ Template::Template(const rapidjson::Document& doc, Renderer& renderer)
 //    float trigger_height = -1;
     
     if (doc.HasMember("view_image") && doc["view_image"].IsString()){
-        this->view_image = renderer.getImagePointer(doc["view_image"].GetString());
+        this->view_image = renderer.getImagePointer(doc["view_image"].GetString(), owner);
     }
     if (doc.HasMember("view_image_back") && doc["view_image_back"].IsString()){
-        this->view_image_back = renderer.getImagePointer(doc["view_image_back"].GetString());
+        this->view_image_back = renderer.getImagePointer(doc["view_image_back"].GetString(), owner);
     }
     if (doc.HasMember("view_image_damage") && doc["view_image_damage"].IsString()){
         // load in actor damaged
-        view_image_damage = renderer.getImagePointer(doc["view_image_damage"].GetString());
+        view_image_damage = renderer.getImagePointer(doc["view_image_damage"].GetString(), owner);
     }
     if (doc.HasMember("view_image_attack") && doc["view_image_attack"].IsString()){
         // load in actor attacked img
-        view_image_attack = renderer.getImagePointer(doc["view_image_attack"].GetString());
+        view_image_attack = renderer.getImagePointer(doc["view_image_attack"].GetString(), owner);
     }
     if (doc.HasMember("transform_scale_x") && doc["transform_scale_x"].IsNumber()){
         this->transform_scale_x = doc["transform_scale_x"].GetDouble();
@@ -97,4 +100,51 @@ Template::Template(const rapidjson::Document& doc, Renderer& renderer)
     
     if (doc.HasMember("box_trigger_height") && doc["box_trigger_height"].IsNumber())
         this->trigger_height = doc["box_trigger_height"].GetFloat();
+
+    if (doc.HasMember("particle_emitters") && doc["particle_emitters"].IsArray())
+        Input::readEmitters(doc["particle_emitters"], renderer, owner, particle_emitters);
+
+    if (doc.HasMember("animations") && doc["animations"].IsObject())
+        readAnimations(doc["animations"], renderer, owner);
+}
+
+void Template::readAnimations(const rapidjson::Value& animationsValue, Renderer& renderer, const std::string& owner)
+{
+    for (auto it = animationsValue.MemberBegin(); it != animationsValue.MemberEnd(); ++it) {
+        std::string stateName = it->name.GetString();
+        const rapidjson::Value& clipValue = it->value;
+        AnimationState state;
+        if (!AnimationSet::stateFromName(stateName, state)) {
+            std::cout << "error: unknown animation " << stateName << " in template " << name;
+            exit(0);
+        }
+        if (!clipValue.IsObject() || !clipValue.HasMember("image") || !clipValue["image"].IsString()
+            || !clipValue.HasMember("frame_width") || !clipValue["frame_width"].IsInt() || clipValue["frame_width"].GetInt() <= 0
+            || !clipValue.HasMember("frame_height") || !clipValue["frame_height"].IsInt() || clipValue["frame_height"].GetInt() <= 0) {
+            std::cout << "error: animation " << stateName << " in template " << name << " needs an image and a positive integer frame_width and frame_height";
+            exit(0);
+        }
+
+        AnimationClip clip;
+        clip.texture = renderer.getImagePointer(clipValue["image"].GetString(), owner);
+        int firstFrame = 0;
+        int frameCount = 0; // 0 = every frame from first_frame to the end of the sheet
+        if (clipValue.HasMember("first_frame") && clipValue["first_frame"].IsInt())
+            firstFrame = clipValue["first_frame"].GetInt();
+        if (clipValue.HasMember("frame_count") && clipValue["frame_count"].IsInt())
+            frameCount = clipValue["frame_count"].GetInt();
+        if (clipValue.HasMember("ticks_per_frame") && clipValue["ticks_per_frame"].IsInt())
+            clip.ticksPerFrame = std::max(1, clipValue["ticks_per_frame"].GetInt());
+        // damage and attack play once from the moment they're triggered
+        clip.loop = state != AnimationState::Damage && state != AnimationState::Attack;
+        if (clipValue.HasMember("loop") && clipValue["loop"].IsBool())
+            clip.loop = clipValue["loop"].GetBool();
+        clip.buildFrames(clipValue["frame_width"].GetInt(), clipValue["frame_height"].GetInt(), firstFrame, frameCount);
+        animations.setClip(state, clip);
+    }
+}
+
+std::string Template::textureOwner(const std::string& templateName)
+{
+    return "template/" + templateName;
 }
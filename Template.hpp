@@ -15,13 +15,17 @@
 #include "rapidjson/document.h"
 #include "Input.hpp"
 #include "Renderer.hpp"
+#include "Animation.hpp"
+#include "ParticleSystem.hpp"
 
 class Template
 {
 public:
     Template() = default;
     //explicit Template(const std::string& templatePath);
-    explicit Template(const rapidjson::Document& doc, Renderer& renderer);
+    explicit Template(const rapidjson::Document& doc, Renderer& renderer, const std::string& templateName);
+    static std::string textureOwner(const std::string& templateName);
+    void readAnimations(const rapidjson::Value& animationsValue, Renderer& renderer, const std::string& owner);
 
 //private:
     // change to protected later and make template a parent class of actor
@@ -47,6 +51,8 @@ public:
     std::optional<float> collider_height;
     std::optional<float> trigger_width;
     std::optional<float> trigger_height;
+    AnimationSet animations;
+    std::vector<EmitterConfig> particle_emitters;
 };
 
 #endif /* Template_hpp */
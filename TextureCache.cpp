@@ -0,0 +1,218 @@
+//
+//  TextureCache.cpp
+//  game_engine
+//
+
+#include "TextureCache.hpp"
+#include <vector>
+#include <algorithm>
+#include "External/Helper.h"
+
+TextureCache::~TextureCache() {
+    clear();
+}
+
+SDL_Texture* TextureCache::find(const std::string& key) {
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        stats.misses++;
+        return nullptr;
+    }
+    stats.hits++;
+    it->second.lastUsedFrame = Helper::GetFrameNumber();
+    return it->second.texture;
+}
+
+SDL_Texture* TextureCache::peek(const std::string& key) const {
+    auto it = entries.find(key);
+    return it == entries.end() ? nullptr : it->second.texture;
+}
+
+bool TextureCache::contains(const std::string& key) const {
+    return entries.find(key) != entries.end();
+}
+
+SDL_Texture* TextureCache::findByHash(uint64_t contentHash) const {
+    if (contentHash == 0) return nullptr;
+    auto it = byHash.find(contentHash);
+    return it == byHash.end() ? nullptr : it->second;
+}
+
+void TextureCache::insert(const std::string& key, SDL_Texture* texture, uint64_t contentHash) {
+    if (!texture) return;
+    size_t residentBefore = stats.residentBytes;
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        // replacing an existing texture keeps its owners
+        if (it->second.texture == texture) return;
+        detach(it->second.texture);
+    }
+    Entry& entry = entries[key];
+    entry.texture = texture;
+    entry.lastUsedFrame = Helper::GetFrameNumber();
+    attach(texture, contentHash);
+    // sharing a texture adds nothing, so it never has to evict (or touch the device)
+    if (stats.residentBytes > residentBefore) {
+        enforceBudget();
+    }
+}
+
+SDL_Texture* TextureCache::replace(const std::string& key, SDL_Texture* texture) {
+    auto it = entries.find(key);
+    if (it == entries.end() || !texture) return nullptr;
+    SDL_Texture* old = it->second.texture;
+    bool wasLast = detach(old, false);
+    it->second.texture = texture;
+    attach(texture, 0);
+    return wasLast ? old : nullptr;
+}
+
+bool TextureCache::isShared(const std::string& key) const {
+    auto it = entries.find(key);
+    if (it == entries.end()) return false;
+    auto resident = residents.find(it->second.texture);
+    return resident != residents.end() && resident->second.keys > 1;
+}
+
+void TextureCache::rehash(const std::string& key, uint64_t contentHash) {
+    auto it = entries.find(key);
+    if (it == entries.end()) return;
+    Resident& resident = residents[it->second.texture];
+    auto hashed = byHash.find(resident.contentHash);
+    if (hashed != byHash.end() && hashed->second == it->second.texture) {
+        byHash.erase(hashed);
+    }
+    resident.contentHash = contentHash;
+    if (contentHash != 0) {
+        byHash[contentHash] = it->second.texture;
+    }
+}
+
+void TextureCache::attach(SDL_Texture* texture, uint64_t contentHash) {
+    Resident& resident = residents[texture];
+    if (resident.keys == 0) {
+        resident.bytes = estimateBytes(texture);
+        resident.contentHash = contentHash;
+        stats.residentBytes += resident.bytes;
+        stats.residentCount++;
+        if (contentHash != 0) {
+            byHash[contentHash] = texture;
+        }
+    }
+    else {
+        stats.sharedCount++;
+        stats.savedBytes += resident.bytes;
+    }
+    resident.keys++;
+}
+
+bool TextureCache::detach(SDL_Texture* texture, bool destroy) {
+    auto it = residents.find(texture);
+    if (it == residents.end()) return false;
+    Resident& resident = it->second;
+    resident.keys--;
+    if (resident.keys > 0) {
+        stats.sharedCount--;
+        stats.savedBytes -= resident.bytes;
+        return false;
+    }
+    stats.residentBytes -= resident.bytes;
+    stats.residentCount--;
+    auto hashed = byHash.find(resident.contentHash);
+    if (hashed != byHash.end() && hashed->second == texture) {
+        byHash.erase(hashed);
+    }
+    residents.erase(it);
+    if (destroy) {
+        SDL_DestroyTexture(texture);
+    }
+    return true;
+}
+
+void TextureCache::retain(const std::string& key, const std::string& owner) {
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+        it->second.owners.insert(owner);
+    }
+}
+
+void TextureCache::releaseOwner(const std::string& owner) {
+    for (auto& pair : entries) {
+        pair.second.owners.erase(owner);
+    }
+}
+
+void TextureCache::evictUnreferenced() {
+    for (auto it = entries.begin(); it != entries.end();) {
+        auto next = std::next(it);
+        if (it->second.owners.empty()) {
+            evict(it);
+        }
+        it = next;
+    }
+}
+
+void TextureCache::enforceBudget() {
+    if (budgetBytes == 0 || stats.residentBytes <= budgetBytes) return;
+
+    // least recently used first, skipping anything drawn this frame or the one before
+    int currFrame = Helper::GetFrameNumber();
+    std::vector<std::unordered_map<std::string, Entry>::iterator> candidates;
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if (it->second.owners.empty() && it->second.lastUsedFrame < currFrame - 1) {
+            candidates.push_back(it);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const auto& a, const auto& b) {
+        return a->second.lastUsedFrame < b->second.lastUsedFrame;
+    });
+    for (auto& it : candidates) {
+        if (stats.residentBytes <= budgetBytes) break;
+        evict(it);
+    }
+}
+
+void TextureCache::evict(std::unordered_map<std::string, Entry>::iterator it) {
+    detach(it->second.texture);
+    stats.evictions++;
+    entries.erase(it);
+}
+
+void TextureCache::setBudget(size_t bytes) {
+    budgetBytes = bytes;
+    enforceBudget();
+}
+
+void TextureCache::clear() {
+    for (auto& pair : residents) {
+        SDL_DestroyTexture(pair.first);
+    }
+    entries.clear();
+    residents.clear();
+    byHash.clear();
+    stats.residentBytes = 0;
+    stats.residentCount = 0;
+    stats.sharedCount = 0;
+    stats.savedBytes = 0;
+}
+
+const TextureStats& TextureCache::getStats() const {
+    return stats;
+}
+
+void TextureCache::printStats(std::ostream& out) const {
+    out << "textures: " << stats.residentCount << " resident, " << stats.residentBytes / 1024 << " KB"
+        << ", hits " << stats.hits << ", misses " << stats.misses << ", evictions " << stats.evictions
+        << ", " << stats.sharedCount << " shared, " << stats.savedBytes / 1024 << " KB saved" << std::endl;
+}
+
+size_t TextureCache::estimateBytes(SDL_Texture* texture) {
+    Uint32 format = 0;
+    int w = 0;
+    int h = 0;
+    SDL_QueryTexture(texture, &format, nullptr, &w, &h);
+    int bytesPerPixel = SDL_BYTESPERPIXEL(format);
+    // unknown formats are assumed to be 32 bit
+    if (bytesPerPixel == 0) bytesPerPixel = 4;
+    return static_cast<size_t>(w) * h * bytesPerPixel;
+}
@@ -0,0 +1,83 @@
+//
+//  TextureCache.hpp
+//  game_engine
+//
+
+#ifndef TextureCache_hpp
+#define TextureCache_hpp
+
+#include <stdio.h>
+#include <string>
+#include <cstdint>
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+#ifdef __APPLE__
+    #include "SDL2/SDL.h"
+#else
+    #include "SDL.h"
+#endif
+
+struct TextureStats {
+    size_t residentBytes = 0;
+    int residentCount = 0;
+    int hits = 0;
+    int misses = 0;
+    int evictions = 0;
+    int sharedCount = 0;    // keys using a texture another key already brought in
+    size_t savedBytes = 0;  // what those would have taken as textures of their own
+};
+
+// keeps track of every resident texture, who is using it and roughly how much memory it takes
+// owners are scene paths or "template/<name>", a texture with no owners can be evicted
+// keys whose files have the same content hash share one texture, it's destroyed with the last of them
+class TextureCache {
+public:
+    ~TextureCache();
+    SDL_Texture* find(const std::string& key);
+    // find without counting as a use
+    SDL_Texture* peek(const std::string& key) const;
+    bool contains(const std::string& key) const;
+    // the resident texture made from a file with this content, if there is one
+    SDL_Texture* findByHash(uint64_t contentHash) const;
+    // a texture already resident under another key is shared, not counted twice (0 = no hash)
+    void insert(const std::string& key, SDL_Texture* texture, uint64_t contentHash = 0);
+    // swaps in a new texture under the same key and owners, the old one is returned, not destroyed
+    // nullptr if other keys are still using the old one
+    SDL_Texture* replace(const std::string& key, SDL_Texture* texture);
+    bool isShared(const std::string& key) const;
+    // after the key's texture was updated in place with different content
+    void rehash(const std::string& key, uint64_t contentHash);
+    void retain(const std::string& key, const std::string& owner);
+    void releaseOwner(const std::string& owner);
+    void evictUnreferenced();
+    void setBudget(size_t bytes);
+    void clear();
+    const TextureStats& getStats() const;
+    void printStats(std::ostream& out) const;
+    static size_t estimateBytes(SDL_Texture* texture);
+private:
+    struct Entry {
+        SDL_Texture* texture = nullptr;
+        std::unordered_set<std::string> owners;
+        int lastUsedFrame = 0;
+    };
+    struct Resident {
+        size_t bytes = 0;
+        int keys = 0;
+        uint64_t contentHash = 0;
+    };
+    void attach(SDL_Texture* texture, uint64_t contentHash);
+    // true if that was the last key using it, destroyed then unless asked not to
+    bool detach(SDL_Texture* texture, bool destroy = true);
+    void evict(std::unordered_map<std::string, Entry>::iterator it);
+    void enforceBudget();
+
+    std::unordered_map<std::string, Entry> entries;
+    std::unordered_map<SDL_Texture*, Resident> residents;
+    std::unordered_map<uint64_t, SDL_Texture*> byHash;
+    size_t budgetBytes = 0; // 0 = no budget
+    TextureStats stats;
+};
+
+#endif /* TextureCache_hpp */
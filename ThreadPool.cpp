@@ -0,0 +1,85 @@
+//
+//  ThreadPool.cpp
+//  game_engine
+//
+
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+ThreadPool::ThreadPool(int numThreads) {
+    if (numThreads <= 0) {
+        numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    for (int i = 0; i < numThreads; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::enqueue(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    jobAvailable.notify_one();
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& job) {
+    if (count == 0) return;
+    // a few ranges per worker so uneven jobs (big and small images) still balance out
+    size_t numRanges = std::min(count, static_cast<size_t>(size()) * 4);
+    size_t rangeSize = (count + numRanges - 1) / numRanges;
+
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+    size_t remaining = 0;
+    for (size_t begin = 0; begin < count; begin += rangeSize) {
+        remaining++;
+    }
+    for (size_t begin = 0; begin < count; begin += rangeSize) {
+        size_t end = std::min(count, begin + rangeSize);
+        enqueue([&, begin, end] {
+            for (size_t i = begin; i < end; ++i) {
+                job(i);
+            }
+            std::lock_guard<std::mutex> lock(doneMutex);
+            remaining--;
+            doneCondition.notify_one();
+        });
+    }
+    std::unique_lock<std::mutex> lock(doneMutex);
+    doneCondition.wait(lock, [&] { return remaining == 0; });
+}
+
+int ThreadPool::size() const {
+    return static_cast<int>(workers.size());
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobAvailable.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping && jobs.empty()) return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        job();
+    }
+}
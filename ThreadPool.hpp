@@ -0,0 +1,37 @@
+//
+//  ThreadPool.hpp
+//  game_engine
+//
+
+#ifndef ThreadPool_hpp
+#define ThreadPool_hpp
+
+#include <stdio.h>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// fixed set of worker threads shared by the loaders, one per core by default
+class ThreadPool {
+public:
+    explicit ThreadPool(int numThreads = 0);
+    ~ThreadPool();
+    static ThreadPool& shared();
+    void enqueue(std::function<void()> job);
+    // runs job(i) for every i in [0, count) across the workers and waits for all of them
+    // don't call this from inside a job, the caller blocks while the workers do the work
+    void parallelFor(size_t count, const std::function<void(size_t)>& job);
+    int size() const;
+private:
+    void workerLoop();
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> jobs;
+    std::mutex mutex;
+    std::condition_variable jobAvailable;
+    bool stopping = false;
+};
+
+#endif /* ThreadPool_hpp */
@@ -61,9 +61,10 @@ static uint64_t create_composite_key(int x, int y) {
     return result;
 }
 
-static TTF_Font* LoadFont(const std::string& fontPath){
+// takes ownership of source, which can read from the resource pack
+static TTF_Font* LoadFont(SDL_RWops* source){
     // size 16
-    TTF_Font* font = TTF_OpenFont(fontPath.c_str(), 16);
+    TTF_Font* font = source ? TTF_OpenFontRW(source, 1, 16) : nullptr;
     if (!font) {
         std::cerr << "Failed to load font: " << TTF_GetError();
         exit(0);
@@ -0,0 +1,146 @@
+//
+//  VoiceManager.cpp
+//  game_engine
+//
+
+#include "VoiceManager.hpp"
+#include "External/Helper.h"
+#include "External/AudioHelper.h"
+#include <algorithm>
+
+void VoiceManager::setChannels(int firstChannel_in, int channelCount) {
+    firstChannel = firstChannel_in;
+    voices.assign(std::max(channelCount, 0), Voice());
+}
+
+void VoiceManager::configure(const VoiceSettings& settings_in) {
+    settings = settings_in;
+}
+
+bool VoiceManager::stealingFromName(const std::string& name, VoiceStealing& stealing) {
+    if (name == "oldest") stealing = VoiceStealing::Oldest;
+    else if (name == "quietest") stealing = VoiceStealing::Quietest;
+    else return false;
+    return true;
+}
+
+const SoundSettings& VoiceManager::soundSettings(const std::string& soundName) const {
+    auto it = settings.sounds.find(soundName);
+    return it == settings.sounds.end() ? settings.defaults : it->second;
+}
+
+void VoiceManager::refresh() {
+    // voices that finished since the last sound started are free again
+    for (size_t i = 0; i < voices.size(); ++i) {
+        if (voices[i].active && !Mix_Playing(firstChannel + static_cast<int>(i))) {
+            voices[i].active = false;
+        }
+    }
+}
+
+template <typename Filter>
+int VoiceManager::pickVictim(Filter filter) const {
+    // least important first, then whichever the stealing mode would rather lose
+    int victim = -1;
+    for (size_t i = 0; i < voices.size(); ++i) {
+        const Voice& voice = voices[i];
+        if (!voice.active || !filter(voice)) continue;
+        if (victim < 0) {
+            victim = static_cast<int>(i);
+            continue;
+        }
+        const Voice& best = voices[victim];
+        bool better = false;
+        if (voice.priority != best.priority) {
+            better = voice.priority < best.priority;
+        }
+        else if (settings.stealing == VoiceStealing::Quietest && voice.volume != best.volume) {
+            better = voice.volume < best.volume;
+        }
+        else {
+            better = voice.startOrder < best.startOrder;
+        }
+        if (better) {
+            victim = static_cast<int>(i);
+        }
+    }
+    return victim;
+}
+
+int VoiceManager::acquire(const std::string& soundName) {
+    int frame = Helper::GetFrameNumber();
+    if (frame != currentFrame) {
+        currentFrame = frame;
+        startedThisFrame = 0;
+    }
+    if (startedThisFrame >= settings.maxNewPerFrame) {
+        stats.droppedFrameCap++;
+        return -1;
+    }
+    refresh();
+
+    const SoundSettings& sound = soundSettings(soundName);
+    int instances = 0;
+    int freeVoice = -1;
+    for (size_t i = 0; i < voices.size(); ++i) {
+        if (voices[i].active) {
+            instances += voices[i].soundName == soundName ? 1 : 0;
+        }
+        else if (freeVoice < 0) {
+            freeVoice = static_cast<int>(i);
+        }
+    }
+    int index = -1;
+    if (instances >= sound.maxInstances) {
+        // at its limit, the sound restarts one of its own copies
+        index = pickVictim([&](const Voice& voice) { return voice.soundName == soundName; });
+    }
+    else if (freeVoice >= 0) {
+        index = freeVoice;
+    }
+    else {
+        index = pickVictim([&](const Voice& voice) { return voice.priority <= sound.priority; });
+    }
+    if (index < 0) {
+        stats.droppedNoVoice++;
+        return -1;
+    }
+
+    Voice& voice = voices[index];
+    if (voice.active) {
+        stats.stolen++;
+    }
+    voice.soundName = soundName;
+    voice.priority = sound.priority;
+    voice.volume = sound.volume;
+    voice.startOrder = nextStartOrder++;
+    voice.active = true;
+    int channel = firstChannel + index;
+    AudioHelper::Mix_Volume498(channel, sound.volume);
+
+    startedThisFrame++;
+    stats.started++;
+    stats.startedBySound[soundName]++;
+    int active = static_cast<int>(std::count_if(voices.begin(), voices.end(), [](const Voice& v) { return v.active; }));
+    stats.peakActive = std::max(stats.peakActive, active);
+    return channel;
+}
+
+const VoiceStats& VoiceManager::getStats() const {
+    return stats;
+}
+
+void VoiceManager::printStats(std::ostream& out) const {
+    if (!settings.report) return;
+    out << "voices: " << stats.started << " started, peak " << stats.peakActive << "/" << voices.size()
+        << ", stolen " << stats.stolen << ", dropped " << stats.droppedFrameCap << " (frame cap) " << stats.droppedNoVoice << " (no voice)";
+    // most played first
+    std::vector<std::pair<std::string, int>> bySound(stats.startedBySound.begin(), stats.startedBySound.end());
+    std::sort(bySound.begin(), bySound.end(), [](const auto& a, const auto& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+    for (const std::pair<std::string, int>& sound : bySound) {
+        out << " | " << sound.first << " " << sound.second;
+    }
+    out << std::endl;
+}
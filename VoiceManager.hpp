@@ -0,0 +1,87 @@
+//
+//  VoiceManager.hpp
+//  game_engine
+//
+
+#ifndef VoiceManager_hpp
+#define VoiceManager_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <unordered_map>
+#ifdef __APPLE__
+    #include "SDL2/SDL.h"
+    #include "SDL2_mixer/SDL_mixer.h"
+#else
+    #include "SDL.h"
+    #include "SDL_mixer.h"
+#endif
+
+enum class VoiceStealing {
+    Oldest,   // the voice that started first
+    Quietest  // the voice with the lowest volume, oldest first among equals
+};
+
+struct SoundSettings {
+    int priority = 0;              // higher wins, a sound only steals voices of its own priority or lower
+    int maxInstances = 8;          // copies playing at once, one more replaces one of its own copies
+    int volume = MIX_MAX_VOLUME;   // 0 - MIX_MAX_VOLUME
+};
+
+// read from game.config's "voices" object
+struct VoiceSettings {
+    int maxNewPerFrame = 8;
+    VoiceStealing stealing = VoiceStealing::Oldest;
+    bool report = false;
+    SoundSettings defaults;
+    std::unordered_map<std::string, SoundSettings> sounds;
+};
+
+struct VoiceStats {
+    int started = 0;
+    int stolen = 0;              // started by cutting off another voice
+    int droppedFrameCap = 0;     // over the frame's limit on new voices
+    int droppedNoVoice = 0;      // every voice busy with something more important
+    int peakActive = 0;
+    std::unordered_map<std::string, int> startedBySound;
+};
+
+// hands out the sound effect channels, so a new sound doesn't cut off whatever was on a channel it picked
+// music and the score sfx keep their own channels outside the range
+class VoiceManager {
+public:
+    void setChannels(int firstChannel, int channelCount);
+    void configure(const VoiceSettings& settings);
+    // the channel to play the sound on with its volume already set, -1 if it shouldn't play
+    int acquire(const std::string& soundName);
+    static bool stealingFromName(const std::string& name, VoiceStealing& stealing);
+    const VoiceStats& getStats() const;
+    // only when "report" is on
+    void printStats(std::ostream& out) const;
+private:
+    struct Voice {
+        std::string soundName;
+        int priority = 0;
+        int volume = 0;
+        uint64_t startOrder = 0;
+        bool active = false;
+    };
+    const SoundSettings& soundSettings(const std::string& soundName) const;
+    void refresh();
+    // the voice to replace among those that pass the filter, -1 if there is none
+    template <typename Filter>
+    int pickVictim(Filter filter) const;
+
+    int firstChannel = 0;
+    std::vector<Voice> voices;
+    VoiceSettings settings;
+    VoiceStats stats;
+    uint64_t nextStartOrder = 0;
+    int currentFrame = -1;
+    int startedThisFrame = 0;
+};
+
+#endif /* VoiceManager_hpp */
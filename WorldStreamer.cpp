@@ -0,0 +1,240 @@
+//
+//  WorldStreamer.cpp
+//  game_engine
+//
+
+#include "WorldStreamer.hpp"
+#include "Scene.hpp"
+#include "Engine.hpp"
+#include "Input.hpp"
+#include "JsonFile.hpp"
+#include "RenderQueue.hpp"
+#include "ResourceManifest.hpp"
+#include "ThreadPool.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <unordered_set>
+
+// chunks built into the scene per frame, the rest wait in the ready queue
+#define CHUNKS_PER_FRAME 1
+
+struct WorldStreamer::PendingChunk {
+    Cell cell;
+    std::string path;
+    rapidjson::Document document; // its own copy, the file is closed on the worker
+    std::vector<DecodedImage> images;
+    bool valid = false;
+    ~PendingChunk() {
+        // dropped before it was built, uploading takes the surfaces otherwise
+        for (DecodedImage& image : images) {
+            if (image.surface) {
+                SDL_FreeSurface(image.surface);
+            }
+        }
+    }
+};
+
+struct WorldStreamer::LoadedChunk {
+    Cell cell;
+    std::string textureOwner;
+    // never grows after it's built, the scene's lists point into it until the chunk unloads
+    std::vector<Actor> actors;
+    std::vector<ActorRecord> records;
+};
+
+static int cellDistance(const std::pair<int, int>& a, const std::pair<int, int>& b) {
+    return std::max(std::abs(a.first - b.first), std::abs(a.second - b.second));
+}
+
+WorldStreamer::WorldStreamer(const std::string& scenePath, const WorldChunkSettings& settings, Renderer& renderer)
+    : settings(settings), renderer(renderer)
+{
+    std::filesystem::path path(scenePath);
+    chunkDirectory = (path.parent_path() / (path.stem().string() + "_chunks")).generic_string();
+}
+
+WorldStreamer::~WorldStreamer() {
+    // the workers write into this, wait for the ones still reading
+    std::unique_lock<std::mutex> lock(readyMutex);
+    jobDone.wait(lock, [this] { return jobsInFlight == 0; });
+}
+
+WorldStreamer::Cell WorldStreamer::cellAt(glm::vec2 position) const {
+    return Cell(static_cast<int>(std::floor(position.x / settings.chunkSize)), static_cast<int>(std::floor(position.y / settings.chunkSize)));
+}
+
+std::string WorldStreamer::chunkPath(Cell cell) const {
+    return chunkDirectory + "/" + std::to_string(cell.first) + "_" + std::to_string(cell.second) + ".chunk";
+}
+
+bool WorldStreamer::isLoaded(Cell cell) const {
+    for (const std::unique_ptr<LoadedChunk>& chunk : loaded) {
+        if (chunk->cell == cell) return true;
+    }
+    return false;
+}
+
+void WorldStreamer::requestAround(Cell center) {
+    // nearest cells first so they reach the ready queue first
+    for (int ring = 0; ring <= settings.loadRadius; ++ring) {
+        for (int dy = -ring; dy <= ring; ++dy) {
+            for (int dx = -ring; dx <= ring; ++dx) {
+                if (std::max(std::abs(dx), std::abs(dy)) != ring) continue;
+                Cell cell(center.first + dx, center.second + dy);
+                if (requested.count(cell) > 0 || isLoaded(cell)) continue;
+                // most of the world is usually empty, those cells simply have no file
+                // and a miss here must not rescan resources/, it happens for most cells every frame
+                if (!ResourceManifest::isIndexed(chunkPath(cell))) continue;
+                request(cell);
+            }
+        }
+    }
+}
+
+void WorldStreamer::request(Cell cell) {
+    requested.insert(cell);
+    std::string path = chunkPath(cell);
+    Uint32 format = renderer.getUploadFormat();
+    {
+        std::lock_guard<std::mutex> lock(readyMutex);
+        jobsInFlight++;
+    }
+    ThreadPool::shared().enqueue([this, cell, path, format] {
+        std::unique_ptr<PendingChunk> pending = std::make_unique<PendingChunk>();
+        pending->cell = cell;
+        pending->path = path;
+        {
+            // a chunk deleted or half written during hot reload is reported by integrate, on the main thread
+            JsonFile file(path, false, false);
+            if (file.isValid()) {
+                pending->document.Parse(file.getText());
+            }
+        }
+        const rapidjson::Document& document = pending->document;
+        pending->valid = !document.HasParseError() && document.IsObject() && document.HasMember("actors") && document["actors"].IsArray();
+        if (pending->valid) {
+            pending->images = renderer.DecodeMissingImages(Input::collectChunkImages(document["actors"]), format);
+        }
+        // notified under the lock, the streamer may be destroyed as soon as it's released
+        std::lock_guard<std::mutex> lock(readyMutex);
+        ready.push_back(std::move(pending));
+        jobsInFlight--;
+        jobDone.notify_all();
+    });
+}
+
+void WorldStreamer::integrate(PendingChunk& pending, Scene& scene, Engine& engine) {
+    if (!pending.valid) {
+        std::cout << "error parsing json at [" << pending.path << "]" << std::endl;
+        exit(0);
+    }
+    renderer.UploadImages(pending.images);
+    std::unique_ptr<LoadedChunk> chunk = std::make_unique<LoadedChunk>();
+    chunk->cell = pending.cell;
+    // released when the chunk unloads, so the cache can evict what only it used
+    chunk->textureOwner = pending.path;
+    Input::buildChunkActors(pending.document["actors"], scene, engine, renderer, chunk->textureOwner, chunk->actors, chunk->records);
+    Input::registerActors(scene, engine, chunk->actors, chunk->records);
+    loaded.push_back(std::move(chunk));
+}
+
+void WorldStreamer::unload(size_t index, Scene& scene) {
+    LoadedChunk& chunk = *loaded[index];
+    std::unordered_set<const Actor*> removed;
+    for (const Actor& actor : chunk.actors) {
+        removed.insert(&actor);
+    }
+    scene.removeActors(removed);
+    renderer.releaseTextures(chunk.textureOwner);
+    // erased in place, the chunks after it keep their load order
+    loaded.erase(loaded.begin() + static_cast<std::ptrdiff_t>(index));
+}
+
+void WorldStreamer::loadAround(Scene& scene, Engine& engine, glm::vec2 position) {
+    requestAround(cellAt(position));
+    std::deque<std::unique_ptr<PendingChunk>> chunks;
+    {
+        std::unique_lock<std::mutex> lock(readyMutex);
+        jobDone.wait(lock, [this] { return jobsInFlight == 0; });
+        chunks.swap(ready);
+    }
+    for (std::unique_ptr<PendingChunk>& pending : chunks) {
+        requested.erase(pending->cell);
+        integrate(*pending, scene, engine);
+    }
+}
+
+void WorldStreamer::update(Scene& scene, Engine& engine, glm::vec2 cameraPosition) {
+    // where the camera will be in lookaheadFrames if the player keeps moving like they did last frame
+    glm::vec2 predicted = cameraPosition;
+    Actor* player = scene.getPlayer();
+    if (player) {
+        glm::vec2 playerPosition = player->getPosition();
+        if (hasLastPlayerPosition) {
+            predicted += (playerPosition - lastPlayerPosition) * static_cast<float>(settings.lookaheadFrames);
+        }
+        lastPlayerPosition = playerPosition;
+        hasLastPlayerPosition = true;
+    }
+    Cell center = cellAt(cameraPosition);
+    Cell ahead = cellAt(predicted);
+    // one cell of slack past the load radius, so walking along a cell edge doesn't load and unload every frame
+    int keepRadius = settings.loadRadius + 1;
+    auto wanted = [&](Cell cell) {
+        return cellDistance(cell, center) <= keepRadius || cellDistance(cell, ahead) <= keepRadius;
+    };
+
+    for (size_t i = loaded.size(); i-- > 0;) {
+        if (!wanted(loaded[i]->cell)) {
+            unload(i, scene);
+        }
+    }
+    requestAround(center);
+    if (ahead != center) {
+        requestAround(ahead);
+    }
+
+    int built = 0;
+    while (built < CHUNKS_PER_FRAME) {
+        std::unique_ptr<PendingChunk> pending;
+        {
+            std::lock_guard<std::mutex> lock(readyMutex);
+            if (ready.empty()) break;
+            pending = std::move(ready.front());
+            ready.pop_front();
+        }
+        requested.erase(pending->cell);
+        // the camera moved on while it was being read
+        if (!wanted(pending->cell)) continue;
+        integrate(*pending, scene, engine);
+        built++;
+    }
+}
+
+void WorldStreamer::unloadAll(Scene& scene) {
+    for (size_t i = loaded.size(); i-- > 0;) {
+        unload(i, scene);
+    }
+}
+
+void WorldStreamer::reloadChunk(Scene& scene, const std::string& path) {
+    for (size_t i = 0; i < loaded.size(); ++i) {
+        if (chunkPath(loaded[i]->cell) == path) {
+            unload(i, scene);
+            return;
+        }
+    }
+}
+
+void WorldStreamer::pushActors(RenderQueue& queue) {
+    for (std::unique_ptr<LoadedChunk>& chunk : loaded) {
+        for (Actor& actor : chunk->actors) {
+            queue.push(&actor);
+        }
+    }
+}
+
+int WorldStreamer::getLoadedCount() const {
+    return static_cast<int>(loaded.size());
+}
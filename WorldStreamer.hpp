@@ -0,0 +1,79 @@
+//
+//  WorldStreamer.hpp
+//  game_engine
+//
+
+#ifndef WorldStreamer_hpp
+#define WorldStreamer_hpp
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <set>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <utility>
+#include "glm/glm.hpp"
+
+class Scene;
+class Engine;
+class Renderer;
+class RenderQueue;
+
+// read from a scene's "world_chunks" object
+struct WorldChunkSettings {
+    float chunkSize = 16.0f;  // scene units per cell side
+    int loadRadius = 1;       // cells kept loaded around the camera's cell, chunks unload one cell further out
+    int lookaheadFrames = 30; // how far ahead of the player's movement chunks are loaded too
+};
+
+// the part of a scene split into world-space cells, each cell's actors in its own chunk file:
+// resources/scenes/<scene>_chunks/<x>_<y>.chunk, laid out like a scene ({"actors": [...]})
+// chunks near the camera are read and their images decoded on the thread pool, then built and
+// registered with the scene on the main thread, a chunk a frame. far chunks are dropped, actors and all
+class WorldStreamer {
+public:
+    WorldStreamer(const std::string& scenePath, const WorldChunkSettings& settings, Renderer& renderer);
+    ~WorldStreamer();
+    WorldStreamer(const WorldStreamer&) = delete;
+    WorldStreamer& operator=(const WorldStreamer&) = delete;
+    // loads every chunk around position before returning, so a scene doesn't start half built
+    void loadAround(Scene& scene, Engine& engine, glm::vec2 position);
+    // once a frame before anything moves
+    void update(Scene& scene, Engine& engine, glm::vec2 cameraPosition);
+    // every chunk is dropped and streams back in over the next frames
+    void unloadAll(Scene& scene);
+    // hot reload: drops the chunk stored at path so the edited file is read again
+    void reloadChunk(Scene& scene, const std::string& path);
+    // chunks are kept in load order, so their actors go in after the scene's still in actorID order
+    void pushActors(RenderQueue& queue);
+    int getLoadedCount() const;
+private:
+    struct PendingChunk;
+    struct LoadedChunk;
+    using Cell = std::pair<int, int>;
+    Cell cellAt(glm::vec2 position) const;
+    std::string chunkPath(Cell cell) const;
+    bool isLoaded(Cell cell) const;
+    void requestAround(Cell center);
+    void request(Cell cell);
+    void integrate(PendingChunk& pending, Scene& scene, Engine& engine);
+    void unload(size_t index, Scene& scene);
+
+    std::string chunkDirectory;
+    WorldChunkSettings settings;
+    Renderer& renderer;
+    glm::vec2 lastPlayerPosition = glm::vec2(0, 0);
+    bool hasLastPlayerPosition = false;
+    std::vector<std::unique_ptr<LoadedChunk>> loaded;
+    std::set<Cell> requested; // queued, being read, or read and waiting to be built
+    // filled by the workers, drained on the main thread
+    std::mutex readyMutex;
+    std::condition_variable jobDone;
+    std::deque<std::unique_ptr<PendingChunk>> ready;
+    int jobsInFlight = 0;
+};
+
+#endif /* WorldStreamer_hpp */
@@ -0,0 +1,105 @@
+//
+//  packer.cpp
+//  game_engine
+//
+//  builds resources.pak from a resources directory, see PackFormat.hpp for the layout
+//  usage: resources_packer [resources dir] [output pak]
+//
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <filesystem>
+#include <unordered_set>
+#include "../PackFormat.hpp"
+
+// what the engine loads, anything else under resources/ is left out
+static const std::unordered_set<std::string> packedExtensions = {
+    ".config", ".scene", ".chunk", ".template", ".png", ".wav", ".ogg", ".ttf"
+};
+
+static void writePadding(std::ofstream& out, uint64_t& offset, uint64_t alignment) {
+    static const char zeros[PACK_ALIGNMENT] = {};
+    uint64_t padding = (alignment - offset % alignment) % alignment;
+    out.write(zeros, static_cast<std::streamsize>(padding));
+    offset += padding;
+}
+
+int main(int argc, char* argv[]) {
+    std::filesystem::path root = argc > 1 ? argv[1] : "resources";
+    std::string outputPath = argc > 2 ? argv[2] : "resources.pak";
+    if (!std::filesystem::is_directory(root)) {
+        std::cout << "error: " << root.string() << " is not a directory" << std::endl;
+        return 1;
+    }
+
+    // sorted so the same resources always make the same pack
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(root)) {
+        if (!entry.is_regular_file()) continue;
+        if (packedExtensions.count(entry.path().extension().string()) == 0) {
+            std::cout << "skipping " << entry.path().generic_string() << std::endl;
+            continue;
+        }
+        files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());
+
+    std::ofstream out(outputPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cout << "error: can't write " << outputPath << std::endl;
+        return 1;
+    }
+    PackHeader header;
+    header.entryCount = static_cast<uint32_t>(files.size());
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    uint64_t offset = sizeof(header);
+
+    std::vector<PackIndexRecord> records;
+    std::vector<std::string> paths;
+    std::vector<char> contents;
+    for (const std::filesystem::path& file : files) {
+        std::ifstream in(file, std::ios::in | std::ios::binary);
+        if (!in.is_open()) {
+            std::cout << "error: can't read " << file.generic_string() << std::endl;
+            return 1;
+        }
+        contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+        writePadding(out, offset, PACK_ALIGNMENT);
+        PackIndexRecord record;
+        record.offset = offset;
+        record.size = contents.size();
+        out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        // the terminator the engine relies on for text entries
+        out.put('\0');
+        offset += contents.size() + 1;
+
+        // stored as the engine asks for it, e.g. resources/images/hero.png
+        std::string path = (std::filesystem::path("resources") / file.lexically_relative(root)).generic_string();
+        record.pathLength = static_cast<uint32_t>(path.size());
+        records.push_back(record);
+        paths.push_back(path);
+    }
+
+    writePadding(out, offset, 8);
+    header.indexOffset = offset;
+    for (size_t i = 0; i < records.size(); ++i) {
+        out.write(reinterpret_cast<const char*>(&records[i]), sizeof(PackIndexRecord));
+        out.write(paths[i].data(), static_cast<std::streamsize>(paths[i].size()));
+        offset += sizeof(PackIndexRecord) + paths[i].size();
+    }
+    header.indexSize = offset - header.indexOffset;
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+    if (!out) {
+        std::cout << "error: failed writing " << outputPath << std::endl;
+        return 1;
+    }
+    std::cout << "packed " << files.size() << " files into " << outputPath << " (" << offset / 1024 << " KB)" << std::endl;
+    return 0;
+}